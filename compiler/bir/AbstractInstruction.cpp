@@ -22,8 +22,8 @@
 
 namespace nballerina {
 
-AbstractInstruction::AbstractInstruction(Operand lOp, BasicBlock &parentBB)
-    : parentBB(parentBB), lhsOp(std::move(lOp)) {}
+AbstractInstruction::AbstractInstruction(Operand lOp, BasicBlock &parentBB, InstructionKind kind)
+    : parentBB(parentBB), lhsOp(std::move(lOp)), kind(kind) {}
 
 const Function &AbstractInstruction::getFunctionRef() const { return parentBB.getParentFunctionRef(); }
 
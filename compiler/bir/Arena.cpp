@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "bir/Arena.h"
+
+namespace nballerina {
+
+Arena::Arena(Arena &&other) noexcept
+    : allocator(std::move(other.allocator)), destructors(std::move(other.destructors)) {
+    other.destructors.clear();
+}
+
+Arena &Arena::operator=(Arena &&other) noexcept {
+    if (this != &other) {
+        destroyAll();
+        allocator = std::move(other.allocator);
+        destructors = std::move(other.destructors);
+        other.destructors.clear();
+    }
+    return *this;
+}
+
+Arena::~Arena() { destroyAll(); }
+
+void Arena::destroyAll() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+        it->second(it->first);
+    }
+    destructors.clear();
+}
+
+size_t Arena::getBytesAllocated() const { return allocator.getBytesAllocated(); }
+
+} // namespace nballerina
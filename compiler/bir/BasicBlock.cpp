@@ -21,15 +21,16 @@
 
 namespace nballerina {
 
-BasicBlock::BasicBlock(std::string pid, Function *parentFunc)
-    : id(std::move(pid)), parentFunction(parentFunc), terminator(nullptr) {}
+BasicBlock::BasicBlock(std::string_view pid, Function *parentFunc)
+    : id(pid), parentFunction(parentFunc), terminator(nullptr) {}
 
-const std::string &BasicBlock::getId() const { return id; }
-TerminatorInsn *BasicBlock::getTerminatorInsnPtr() const { return terminator.get(); }
+std::string_view BasicBlock::getId() const { return id; }
+TerminatorInsn *BasicBlock::getTerminatorInsnPtr() const { return terminator; }
 
 const Function &BasicBlock::getParentFunctionRef() const { return *parentFunction; }
+Arena &BasicBlock::getArena() { return parentFunction->getArena(); }
 
-void BasicBlock::setTerminatorInsn(std::unique_ptr<TerminatorInsn> insn) { terminator = std::move(insn); }
-void BasicBlock::addNonTermInsn(std::unique_ptr<NonTerminatorInsn> insn) { instructions.push_back(std::move(insn)); }
+void BasicBlock::setTerminatorInsn(TerminatorInsn *insn) { terminator = insn; }
+void BasicBlock::addNonTermInsn(NonTerminatorInsn *insn) { instructions.push_back(insn); }
 
 } // namespace nballerina
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "bir/CompilerStats.h"
+#include "bir/BasicBlock.h"
+#include "bir/Function.h"
+#include "bir/Package.h"
+#include "interfaces/NonTerminatorInsn.h"
+#include "interfaces/TerminatorInsn.h"
+#include <llvm/Support/Format.h>
+#include <algorithm>
+#include <map>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace nballerina {
+
+// How many of the slowest functions --stats lists
+static constexpr size_t SLOWEST_FUNCTION_COUNT = 10;
+
+static const char *getInstructionKindName(InstructionKind kind) {
+    switch (kind) {
+    case INSTRUCTION_KIND_GOTO:
+        return "goto";
+    case INSTRUCTION_KIND_CALL:
+        return "call";
+    case INSTRUCTION_KIND_CONDITIONAL_BRANCH:
+        return "branch";
+    case INSTRUCTION_KIND_RETURN:
+        return "return";
+    case INSTRUCTION_KIND_MOVE:
+        return "move";
+    case INSTRUCTION_KIND_CONST_LOAD:
+        return "const load";
+    case INSTRUCTION_KIND_NEW_STRUCTURE:
+        return "new structure";
+    case INSTRUCTION_KIND_MAP_STORE:
+        return "map store";
+    case INSTRUCTION_KIND_MAP_LOAD:
+        return "map load";
+    case INSTRUCTION_KIND_NEW_ARRAY:
+        return "new array";
+    case INSTRUCTION_KIND_ARRAY_STORE:
+        return "array store";
+    case INSTRUCTION_KIND_ARRAY_LOAD:
+        return "array load";
+    case INSTRUCTION_KIND_TYPE_CAST:
+        return "type cast";
+    case INSTRUCTION_KIND_TYPE_TEST:
+        return "type test";
+    case INSTRUCTION_KIND_NEW_TYPEDESC:
+        return "new typedesc";
+    case INSTRUCTION_KIND_BINARY_ADD:
+        return "add";
+    case INSTRUCTION_KIND_BINARY_SUB:
+        return "sub";
+    case INSTRUCTION_KIND_BINARY_MUL:
+        return "mul";
+    case INSTRUCTION_KIND_BINARY_DIV:
+        return "div";
+    case INSTRUCTION_KIND_BINARY_MOD:
+        return "mod";
+    case INSTRUCTION_KIND_BINARY_EQUAL:
+        return "equal";
+    case INSTRUCTION_KIND_BINARY_NOT_EQUAL:
+        return "not equal";
+    case INSTRUCTION_KIND_BINARY_GREATER_THAN:
+        return "greater than";
+    case INSTRUCTION_KIND_BINARY_GREATER_EQUAL:
+        return "greater equal";
+    case INSTRUCTION_KIND_BINARY_LESS_THAN:
+        return "less than";
+    case INSTRUCTION_KIND_BINARY_LESS_EQUAL:
+        return "less equal";
+    case INSTRUCTION_KIND_BINARY_BITWISE_XOR:
+        return "bitwise xor";
+    case INSTRUCTION_KIND_UNARY_NOT:
+        return "not";
+    case INSTRUCTION_KIND_UNARY_NEG:
+        return "neg";
+    default:
+        return "other";
+    }
+}
+
+void CompilerStats::enableStats() { statsEnabled = true; }
+
+bool CompilerStats::isStatsEnabled() { return statsEnabled; }
+
+void CompilerStats::enableTimeTrace(unsigned granularity) {
+    timeTraceGranularity = granularity;
+    timeTraceEnabled = true;
+    llvm::timeTraceProfilerInitialize(granularity, "nballerinacc");
+}
+
+bool CompilerStats::isTimeTraceEnabled() { return timeTraceEnabled; }
+
+unsigned CompilerStats::getTimeTraceGranularity() { return timeTraceGranularity; }
+
+size_t CompilerStats::getPeakRSS() {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// Phases run more than once (per partition, per worker) are added up
+void CompilerStats::recordPhase(llvm::StringRef name, double seconds, size_t startPeakRSS,
+                                std::optional<size_t> allocatedBytes) {
+    size_t endPeakRSS = allocatedBytes ? 0 : getPeakRSS();
+    std::lock_guard<std::mutex> lock(statsLock);
+    auto phase = std::find_if(phases.begin(), phases.end(), [&](const Phase &p) { return p.name == name; });
+    if (phase == phases.end()) {
+        phases.push_back(Phase{name.str()});
+        phase = std::prev(phases.end());
+    }
+    phase->count++;
+    phase->seconds += seconds;
+    if (allocatedBytes) {
+        phase->allocationsKnown = true;
+        phase->allocatedBytes += *allocatedBytes;
+        return;
+    }
+    // Growth another instance of this phase already counted is skipped
+    auto fromPeakRSS = std::max(startPeakRSS, phase->accountedPeakRSS);
+    if (endPeakRSS > fromPeakRSS) {
+        phase->peakRSSGrowth += endPeakRSS - fromPeakRSS;
+        phase->accountedPeakRSS = endPeakRSS;
+    }
+}
+
+void CompilerStats::recordFunction(llvm::StringRef name, double seconds) {
+    std::lock_guard<std::mutex> lock(statsLock);
+    functionTimes.push_back(FunctionTime{name.str(), seconds});
+}
+
+void CompilerStats::print(llvm::raw_ostream &os, const Package &package, bool bodiesReleased) {
+    std::lock_guard<std::mutex> lock(statsLock);
+    // Phases that can not tell what they allocated fall back to the growth
+    // of the process peak RSS, which stays 0 once the peak has been reached
+    os << "  Phase                    count   time (ms)  memory (KiB)\n";
+    for (const auto &phase : phases) {
+        auto memory = phase.allocationsKnown ? phase.allocatedBytes : phase.peakRSSGrowth;
+        os << llvm::format("  %-24s %5u %11.2f %13zu  ", phase.name.c_str(), phase.count, phase.seconds * 1000,
+                           memory / 1024)
+           << (phase.allocationsKnown ? "allocated" : "peak RSS growth") << "\n";
+    }
+    os << llvm::format("Peak RSS: %zu KiB\n", getPeakRSS() / 1024);
+
+    if (!bodiesReleased) {
+        os << llvm::format("Decoded IR: %zu KiB in function arenas\n", package.getArenaBytes() / 1024);
+
+        std::map<InstructionKind, size_t> kindCounts;
+        size_t instructionCount = 0;
+        for (const auto &function : package.functions) {
+            for (const auto *basicBlock : function.basicBlocks) {
+                for (const auto *insn : basicBlock->instructions) {
+                    kindCounts[insn->getKind()]++;
+                }
+                if (basicBlock->getTerminatorInsnPtr() != nullptr) {
+                    kindCounts[basicBlock->getTerminatorInsnPtr()->getKind()]++;
+                }
+            }
+            instructionCount += function.getInstructionCount();
+        }
+        os << "Instructions: " << instructionCount << " in " << package.functions.size() << " functions\n";
+        for (const auto &[kind, count] : kindCounts) {
+            os << llvm::format("  %-24s %8zu\n", getInstructionKindName(kind), count);
+        }
+    }
+
+    if (!functionTimes.empty()) {
+        auto slowest = functionTimes;
+        size_t shown = std::min(slowest.size(), SLOWEST_FUNCTION_COUNT);
+        std::partial_sort(slowest.begin(), slowest.begin() + shown, slowest.end(),
+                          [](const FunctionTime &lhs, const FunctionTime &rhs) { return lhs.seconds > rhs.seconds; });
+        os << "Slowest functions (ms):\n";
+        for (size_t i = 0; i < shown; i++) {
+            os << llvm::format("  %10.3f  ", slowest[i].seconds * 1000) << slowest[i].name << "\n";
+        }
+    }
+}
+
+PhaseScope::PhaseScope(llvm::StringRef name, llvm::StringRef detail)
+    : traceScope(name, detail), name(name), detail(detail) {
+    if (CompilerStats::isStatsEnabled()) {
+        start = std::chrono::steady_clock::now();
+        startPeakRSS = CompilerStats::getPeakRSS();
+    }
+}
+
+PhaseScope::~PhaseScope() {
+    if (!CompilerStats::isStatsEnabled()) {
+        return;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    CompilerStats::recordPhase(name, elapsed.count(), startPeakRSS, allocatedBytes);
+    if (!detail.empty()) {
+        CompilerStats::recordFunction(detail, elapsed.count());
+    }
+}
+
+void PhaseScope::setAllocatedBytes(size_t bytes) { allocatedBytes = bytes; }
+
+TraceThreadScope::TraceThreadScope() {
+    if (CompilerStats::isTimeTraceEnabled() && !llvm::timeTraceProfilerEnabled()) {
+        llvm::timeTraceProfilerInitialize(CompilerStats::getTimeTraceGranularity(), "nballerinacc");
+        attached = true;
+    }
+}
+
+TraceThreadScope::~TraceThreadScope() {
+    if (attached) {
+        llvm::timeTraceProfilerFinishThread();
+    }
+}
+
+} // namespace nballerina
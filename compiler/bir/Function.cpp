@@ -17,39 +17,128 @@
  */
 
 #include "bir/Function.h"
+#include "bir/FunctionCallInsn.h"
 #include "bir/Package.h"
 #include "bir/Types.h"
-#include <algorithm>
 #include <cassert>
 
 namespace nballerina {
 
-Function::Function(Package *parentPackage, std::string name, std::string workerName, unsigned int flags)
-    : parentPackage(parentPackage), name(std::move(name)), workerName(std::move(workerName)), flags(flags) {}
+Function::Function(Package *parentPackage, std::string_view name, std::string_view workerName, unsigned int flags)
+    : parentPackage(parentPackage), name(name), workerName(workerName), flags(flags) {}
 
-const std::string &Function::getName() const { return name; }
+Function::Function(Function &&other) noexcept
+    : Debuggable(std::move(other)), parentPackage(other.parentPackage), arena(std::move(other.arena)),
+      name(other.name), workerName(other.workerName), flags(other.flags), signature(std::move(other.signature)),
+      returnVar(std::move(other.returnVar)), restParam(std::move(other.restParam)),
+      localVars(std::move(other.localVars)), localVarIndices(std::move(other.localVarIndices)),
+      basicBlocks(std::move(other.basicBlocks)), requiredParams(std::move(other.requiredParams)) {
+    adoptBasicBlocks();
+}
+
+Function &Function::operator=(Function &&other) noexcept {
+    Debuggable::operator=(std::move(other));
+    parentPackage = other.parentPackage;
+    arena = std::move(other.arena);
+    name = other.name;
+    workerName = other.workerName;
+    flags = other.flags;
+    signature = std::move(other.signature);
+    returnVar = std::move(other.returnVar);
+    restParam = std::move(other.restParam);
+    localVars = std::move(other.localVars);
+    localVarIndices = std::move(other.localVarIndices);
+    basicBlocks = std::move(other.basicBlocks);
+    requiredParams = std::move(other.requiredParams);
+    adoptBasicBlocks();
+    return *this;
+}
+
+void Function::adoptBasicBlocks() {
+    for (auto *basicBlock : basicBlocks) {
+        basicBlock->parentFunction = this;
+    }
+}
+
+std::string_view Function::getName() const { return name; }
 const std::vector<FunctionParam> &Function::getParams() const { return requiredParams; }
 const std::optional<RestParam> &Function::getRestParam() const { return restParam; }
 const std::optional<Variable> &Function::getReturnVar() const { return returnVar; }
+const std::optional<InvocableType> &Function::getSignature() const { return signature; }
 
 const Variable &Function::getLocalOrGlobalVariable(const Operand &op) const {
     if (op.getKind() == GLOBAL_VAR_KIND) {
+        if (op.getIndex() != INVALID_VAR_INDEX) {
+            return parentPackage->getGlobalVariableAt(op.getIndex());
+        }
         return parentPackage->getGlobalVariable(op.getName());
     }
+    if (op.getIndex() != INVALID_VAR_INDEX) {
+        assert(op.getIndex() < localVars.size());
+        return localVars[op.getIndex()];
+    }
     return getLocalVariable(op.getName());
 }
 
-const Variable &Function::getLocalVariable(const std::string &opName) const {
-    auto result = std::find_if(localVars.begin(), localVars.end(),
-                               [&opName](const Variable &i) -> bool { return i.getName() == opName; });
-    assert(result != localVars.end());
-    return *result;
+const Variable &Function::getLocalVariable(std::string_view opName) const {
+    auto index = getLocalVarIndex(opName);
+    assert(index != INVALID_VAR_INDEX);
+    return localVars[index];
+}
+
+uint32_t Function::getLocalVarIndex(std::string_view opName) const {
+    auto result = localVarIndices.find(opName);
+    if (result == localVarIndices.end()) {
+        return INVALID_VAR_INDEX;
+    }
+    return result->second;
+}
+
+uint32_t Function::getVariableIndex(std::string_view opName, VarKind kind) const {
+    if (kind == GLOBAL_VAR_KIND) {
+        return parentPackage->getGlobalVarIndex(opName);
+    }
+    return getLocalVarIndex(opName);
+}
+
+void Function::releaseBody() {
+    // Swapped with empty containers, clear() would keep the capacity
+    std::vector<BasicBlock *>().swap(basicBlocks);
+    std::vector<Variable>().swap(localVars);
+    std::unordered_map<std::string_view, uint32_t>().swap(localVarIndices);
+    std::vector<FunctionParam>().swap(requiredParams);
+    arena = Arena();
 }
 
+Arena &Function::getArena() { return arena; }
+const Arena &Function::getArena() const { return arena; }
+
 size_t Function::getNumParams() const { return requiredParams.size(); }
 
 bool Function::isMainFunction() const { return (name == MAIN_FUNCTION_NAME); }
 
 bool Function::isExternalFunction() const { return ((flags & NATIVE) == NATIVE); }
 
+bool Function::isPublicFunction() const { return ((flags & PUBLIC) == PUBLIC); }
+
+size_t Function::getInstructionCount() const {
+    size_t count = 0;
+    for (const auto *basicBlock : basicBlocks) {
+        // Instructions plus the terminator
+        count += basicBlock->instructions.size() + 1;
+    }
+    return count;
+}
+
+std::vector<std::string_view> Function::getCalleeNames() const {
+    std::vector<std::string_view> calleeNames;
+    for (const auto *basicBlock : basicBlocks) {
+        const auto *terminator = basicBlock->getTerminatorInsnPtr();
+        if (terminator != nullptr && terminator->getKind() == INSTRUCTION_KIND_CALL) {
+            calleeNames.push_back(static_cast<const FunctionCallInsn *>(terminator)->getFunctionName());
+        }
+    }
+    return calleeNames;
+}
+
 } // namespace nballerina
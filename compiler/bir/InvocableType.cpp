@@ -20,10 +20,14 @@
 
 namespace nballerina {
 
-InvocableType::InvocableType(std::vector<Type> paramTy, Type restTy, Type retTy)
-    : paramTypes(std::move(paramTy)), returnType(std::move(retTy)), restType(std::move(restTy)) {}
+InvocableType::InvocableType(std::vector<const Type *> paramTy, const Type &restTy, const Type &retTy)
+    : paramTypes(std::move(paramTy)), returnType(&retTy), restType(&restTy) {}
 
-InvocableType::InvocableType(std::vector<Type> paramTy, Type retTy)
-    : paramTypes(std::move(paramTy)), returnType(std::move(retTy)) {}
+InvocableType::InvocableType(std::vector<const Type *> paramTy, const Type &retTy)
+    : paramTypes(std::move(paramTy)), returnType(&retTy), restType(nullptr) {}
+
+const std::vector<const Type *> &InvocableType::getParamTypes() const { return paramTypes; }
+const Type &InvocableType::getReturnType() const { return *returnType; }
+const Type *InvocableType::getRestType() const { return restType; }
 
 } // namespace nballerina
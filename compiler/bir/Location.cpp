@@ -20,10 +20,10 @@
 
 namespace nballerina {
 
-Location::Location(std::string name, int sline, int scol, int eline, int ecol)
-    : fileName(std::move(name)), sLine(sline), sCol(scol), eLine(eline), eCol(ecol) {}
+Location::Location(std::string_view name, int sline, int scol, int eline, int ecol)
+    : fileName(name), sLine(sline), sCol(scol), eLine(eline), eCol(ecol) {}
 
-const std::string &Location::getFileName() const { return fileName; }
+std::string_view Location::getFileName() const { return fileName; }
 int Location::getStartLineNum() const { return sLine; }
 int Location::getStartColumnNum() const { return sCol; }
 int Location::getEndLineNum() const { return eLine; }
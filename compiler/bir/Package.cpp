@@ -17,25 +17,53 @@
  */
 
 #include "bir/Package.h"
-#include <algorithm>
 #include <cassert>
 
 namespace nballerina {
 
 std::string Package::getModuleName() const { return org + name + version; }
 
-const Function &Package::getFunction(const std::string &name) const {
-    auto result = std::find_if(functions.begin(), functions.end(),
-                               [&name](const Function &i) -> bool { return i.getName() == name; });
-    assert(result != functions.end());
-    return *result;
+SymbolTable &Package::getSymbolTable() { return symbols; }
+
+TypeTable &Package::getTypeTable() { return types; }
+
+const TypeTable &Package::getTypeTable() const { return types; }
+
+size_t Package::getArenaBytes() const {
+    size_t bytes = 0;
+    for (const auto &function : functions) {
+        bytes += function.getArena().getBytesAllocated();
+    }
+    return bytes;
+}
+
+size_t Package::getAllocatedBytes() const { return getArenaBytes() + symbols.getBytesAllocated(); }
+
+bool Package::isFromPackageCache() const { return backingBuffer != nullptr; }
+
+const Function &Package::getFunction(std::string_view name) const {
+    auto result = functionIndices.find(name);
+    assert(result != functionIndices.end());
+    return functions[result->second];
+}
+
+const Variable &Package::getGlobalVariable(std::string_view name) const {
+    auto index = getGlobalVarIndex(name);
+    assert(index != INVALID_VAR_INDEX);
+    return globalVars[index];
+}
+
+const Variable &Package::getGlobalVariableAt(uint32_t index) const {
+    assert(index < globalVars.size());
+    return globalVars[index];
 }
 
-const Variable &Package::getGlobalVariable(const std::string &name) const {
-    auto result = std::find_if(globalVars.begin(), globalVars.end(),
-                               [&name](const Variable &i) -> bool { return i.getName() == name; });
-    assert(result != globalVars.end());
-    return *result;
+uint32_t Package::getGlobalVarIndex(std::string_view name) const {
+    auto result = globalVarIndices.find(name);
+    if (result == globalVarIndices.end()) {
+        return INVALID_VAR_INDEX;
+    }
+    return result->second;
 }
 
 } // namespace nballerina
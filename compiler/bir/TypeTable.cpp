@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "bir/TypeTable.h"
+#include <cassert>
+
+namespace nballerina {
+
+TypeTable::TypeKey TypeTable::keyOf(const Type &type) {
+    auto tag = type.getTypeTag();
+    if (tag == TYPE_TAG_ARRAY) {
+        auto &arrayType = type.getArrayType();
+        return TypeKey(tag, type.getName(), arrayType.memberType, arrayType.size, arrayType.state);
+    }
+    if (tag == TYPE_TAG_MAP) {
+        return TypeKey(tag, type.getName(), type.getMemberTypeTag(), 0, 0);
+    }
+    return TypeKey(tag, type.getName(), TYPE_TAG_INVALID, 0, 0);
+}
+
+const Type &TypeTable::intern(Type type) {
+    auto key = keyOf(type);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        return *it->second;
+    }
+    type.index = static_cast<TypeIndex>(types.size());
+    types.push_back(std::move(type));
+    index.emplace(std::move(key), &types.back());
+    return types.back();
+}
+
+const Type &TypeTable::get(TypeIndex typeIndex) const {
+    assert(typeIndex < types.size());
+    return types[typeIndex];
+}
+
+size_t TypeTable::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return types.size();
+}
+
+} // namespace nballerina
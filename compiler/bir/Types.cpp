@@ -30,6 +30,12 @@ Type::Type(TypeTag type, std::string namep, MapType mapType) : type(type), name(
 
 TypeTag Type::getTypeTag() const { return type; }
 
+TypeIndex Type::getIndex() const { return index; }
+
+std::string_view Type::getName() const { return name; }
+
+const Type::ArrayType &Type::getArrayType() const { return std::get<Type::ArrayType>(typeInfo); }
+
 TypeTag Type::getMemberTypeTag() const {
     if (type == TYPE_TAG_ARRAY) {
         return std::get<Type::ArrayType>(typeInfo).memberType;
@@ -31,14 +31,14 @@ void NonTerminatorInsnCodeGen::visit(ArrayInsn &obj, llvm::IRBuilder<> &builder)
     auto *lhsOpRef = functionGenerator.getLocalOrGlobalVal(obj.lhsOp);
     const auto &lhsVar = obj.getFunctionRef().getLocalOrGlobalVariable(obj.lhsOp);
     TypeTag memberTypeTag = lhsVar.getType().getMemberTypeTag();
-    auto arrayInitFunc = CodeGenUtils::getArrayInitFunc(moduleGenerator.getModule(), memberTypeTag);
+    auto arrayInitFunc = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_ARRAY_INIT, memberTypeTag);
     auto *newArrayRef = builder.CreateCall(arrayInitFunc, llvm::ArrayRef<llvm::Value *>({sizeOpValueRef}));
     builder.CreateStore(newArrayRef, lhsOpRef);
 }
 
 void NonTerminatorInsnCodeGen::visit(ArrayLoadInsn &obj, llvm::IRBuilder<> &builder) {
     const auto &lhsOpTypeTag = obj.getFunctionRef().getLocalOrGlobalVariable(obj.lhsOp).getType().getTypeTag();
-    auto ArrayLoadFunc = CodeGenUtils::getArrayLoadFunc(moduleGenerator.getModule(), lhsOpTypeTag);
+    auto ArrayLoadFunc = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_ARRAY_LOAD, lhsOpTypeTag);
 
     auto *lhsOpRef = functionGenerator.getLocalOrGlobalVal(obj.lhsOp);
     auto *rhsOpTempRef = functionGenerator.createTempVal(obj.rhsOp, builder);
@@ -56,7 +56,7 @@ void NonTerminatorInsnCodeGen::visit(ArrayLoadInsn &obj, llvm::IRBuilder<> &buil
 
 void NonTerminatorInsnCodeGen::visit(ArrayStoreInsn &obj, llvm::IRBuilder<> &builder) {
     const auto &rhsOpTypeTag = obj.getFunctionRef().getLocalOrGlobalVariable(obj.rhsOp).getType().getTypeTag();
-    auto ArrayLoadFunc = CodeGenUtils::getArrayStoreFunc(moduleGenerator.getModule(), rhsOpTypeTag);
+    auto ArrayLoadFunc = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_ARRAY_STORE, rhsOpTypeTag);
     auto *lhsOpRef = functionGenerator.getLocalOrGlobalVal(obj.lhsOp);
     auto *memVal = Type::isBalValueType(rhsOpTypeTag) ? functionGenerator.getLocalOrGlobalVal(obj.rhsOp)
                                                       : functionGenerator.createTempVal(obj.rhsOp, builder);
@@ -18,25 +18,22 @@
 
 #include "codegen/BasicBlockCodeGen.h"
 #include "bir/BasicBlock.h"
-#include "codegen/NonTerminatorInsnCodeGen.h"
-#include "codegen/TerminatorInsnCodeGen.h"
 #include "interfaces/NonTerminatorInsn.h"
 #include "interfaces/TerminatorInsn.h"
 
 namespace nballerina {
 
 BasicBlockCodeGen::BasicBlockCodeGen(FunctionCodeGen &functionGenerator, PackageCodeGen &moduleGenerator)
-    : functionGenerator(functionGenerator), moduleGenerator(moduleGenerator) {}
+    : nonTerminatorGenerator(functionGenerator, moduleGenerator),
+      terminatorGenerator(functionGenerator, moduleGenerator) {}
 
 void BasicBlockCodeGen::visit(BasicBlock &obj, llvm::IRBuilder<> &builder) {
 
-    for (const auto &instruction : obj.instructions) {
-        NonTerminatorInsnCodeGen generator(functionGenerator, moduleGenerator);
-        instruction->accept(generator, builder);
+    for (auto *instruction : obj.instructions) {
+        nonTerminatorGenerator.visit(*instruction, builder);
     }
     if (obj.terminator != nullptr) {
-        TerminatorInsnCodeGen generator(functionGenerator, moduleGenerator);
-        obj.terminator->accept(generator, builder);
+        terminatorGenerator.visit(*obj.terminator, builder);
     }
 }
 } // namespace nballerina
@@ -27,7 +27,7 @@ namespace nballerina {
 
 void NonTerminatorInsnCodeGen::visit(class BinaryOpInsn &obj, llvm::IRBuilder<> &builder) {
 
-    const std::string lhsTempName = obj.lhsOp.getName() + "_temp";
+    const std::string lhsTempName = std::string(obj.lhsOp.getName()) + "_temp";
     auto *lhsRef = functionGenerator.getLocalOrGlobalVal(obj.lhsOp);
     auto *rhsOp1ref = functionGenerator.createTempVal(obj.rhsOp1, builder);
     auto *rhsOp2ref = functionGenerator.createTempVal(obj.rhsOp2, builder);
@@ -17,6 +17,9 @@
  */
 
 #include "codegen/CodeGenUtils.h"
+#include <llvm/IR/Dominators.h>
+#include <llvm/Transforms/Utils/PromoteMemToReg.h>
+#include <vector>
 
 namespace nballerina {
 
@@ -190,7 +193,10 @@ llvm::Function *CodeGenUtils::createIntToAnyFunction(llvm::Module &module) {
     // create new int_to_any function
     auto *funcType =
         llvm::FunctionType::get(builder.getInt8PtrTy(), llvm::ArrayRef<llvm::Type *>({builder.getInt64Ty()}), false);
-    auto *newFunc = llvm::Function::Create(funcType, llvm::GlobalValue::ExternalLinkage, functionName, module);
+    // Every module that uses it has a copy, so partitions of a package link
+    auto *newFunc = llvm::Function::Create(funcType, llvm::GlobalValue::LinkOnceODRLinkage, functionName, module);
+    // Small enough to always pay off, see CodeGenerator::optimize
+    newFunc->addFnAttr(llvm::Attribute::AlwaysInline);
 
     llvm::BasicBlock *entryBB = llvm::BasicBlock::Create(module.getContext(), "entry", newFunc);
     builder.SetInsertPoint(entryBB);
@@ -253,6 +259,7 @@ llvm::Function *CodeGenUtils::createIntToAnyFunction(llvm::Module &module) {
     builder.SetInsertPoint(retBB);
     builder.CreateRet(builder.CreateLoad(localVarRef1, ""));
 
+    promoteStackSlots(*newFunc);
     return newFunc;
 }
 
@@ -273,7 +280,9 @@ llvm::Function *CodeGenUtils::createAnyToIntFunction(llvm::Module &module) {
     // create new any_to_int function
     auto *funcType =
         llvm::FunctionType::get(builder.getInt64Ty(), llvm::ArrayRef<llvm::Type *>({builder.getInt8PtrTy()}), false);
-    auto *newFunc = llvm::Function::Create(funcType, llvm::GlobalValue::ExternalLinkage, functionName, module);
+    auto *newFunc = llvm::Function::Create(funcType, llvm::GlobalValue::LinkOnceODRLinkage, functionName, module);
+    // Small enough to always pay off, see CodeGenerator::optimize
+    newFunc->addFnAttr(llvm::Attribute::AlwaysInline);
 
     llvm::BasicBlock *entryBB = llvm::BasicBlock::Create(module.getContext(), "entry", newFunc);
     builder.SetInsertPoint(entryBB);
@@ -342,6 +351,7 @@ llvm::Function *CodeGenUtils::createAnyToIntFunction(llvm::Module &module) {
     builder.SetInsertPoint(retBB);
     builder.CreateRet(builder.CreateLoad(localVarRef1, ""));
 
+    promoteStackSlots(*newFunc);
     return newFunc;
 }
 
@@ -381,4 +391,44 @@ llvm::FunctionCallee CodeGenUtils::getMapStoreFunc(llvm::Module &module) {
     return module.getOrInsertFunction("bal_map_insert", funcType);
 }
 
+void CodeGenUtils::promoteStackSlots(llvm::Function &function) {
+    std::vector<llvm::AllocaInst *> promotable;
+    for (auto &insn : function.getEntryBlock()) {
+        auto *alloca = llvm::dyn_cast<llvm::AllocaInst>(&insn);
+        if (alloca != nullptr && llvm::isAllocaPromotable(alloca)) {
+            promotable.push_back(alloca);
+        }
+    }
+    if (promotable.empty()) {
+        return;
+    }
+    llvm::DominatorTree dominators(function);
+    llvm::PromoteMemToReg(promotable, dominators);
+}
+
+llvm::FunctionCallee CodeGenUtils::getRuntimeFunction(llvm::Module &module, RuntimeFunction function,
+                                                      TypeTag memberTypeTag) {
+    switch (function) {
+    case RUNTIME_FUNCTION_STRING_INIT:
+        return getStringInitFunc(module);
+    case RUNTIME_FUNCTION_ARRAY_INIT:
+        return getArrayInitFunc(module, memberTypeTag);
+    case RUNTIME_FUNCTION_ARRAY_STORE:
+        return getArrayStoreFunc(module, memberTypeTag);
+    case RUNTIME_FUNCTION_ARRAY_LOAD:
+        return getArrayLoadFunc(module, memberTypeTag);
+    case RUNTIME_FUNCTION_MAP_CREATE:
+        return getNewMapInitFunc(module);
+    case RUNTIME_FUNCTION_MAP_LOAD:
+        return getMapLoadFunc(module);
+    case RUNTIME_FUNCTION_MAP_STORE:
+        return getMapStoreFunc(module);
+    case RUNTIME_FUNCTION_MAP_SPREAD_FIELD_INIT:
+        return getMapSpreadFieldInitFunc(module);
+    case RUNTIME_FUNCTION_ANY_TO_INT:
+        return getAnyToIntFunction(module);
+    }
+    llvm_unreachable("Unknown runtime function");
+}
+
 } // namespace nballerina
@@ -17,21 +17,59 @@
  */
 
 #include "codegen/CodeGenerator.h"
+#include "bir/CompilerStats.h"
 #include "bir/Package.h"
 #include "codegen/PackageCodeGen.h"
 #include <llvm/ADT/Triple.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/IPO/ThinLTOBitcodeWriter.h>
+#include <llvm/Transforms/Scalar/SROA.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 namespace nballerina {
 
-int CodeGenerator::generateLLVMIR(Package &translatableObj, const std::string &outFileName) {
+int CodeGenerator::generateLLVMIR(Package &translatableObj, const std::string &outFileName,
+                                  const CodeGenOptions &options) {
+    if (options.partitions > 1) {
+        return generatePartitions(translatableObj, outFileName, options);
+    }
+    llvm::LLVMContext mContext;
+    return generateLLVMIR(translatableObj, outFileName, mContext, options);
+}
 
-    auto mContext = llvm::LLVMContext();
-    auto mod = llvm::Module(translatableObj.getModuleName(), mContext);
-    auto builder = llvm::IRBuilder<>(mContext);
+void CodeGenerator::translate(Package &translatableObj, llvm::Module &mod, const ModulePartition *partition) {
+    PhaseScope phase("Translate");
+    auto builder = llvm::IRBuilder<>(mod.getContext());
+    setTarget(mod);
+
+    // Codegen
+    PackageCodeGen generator(mod);
+    if (partition != nullptr) {
+        generator.visit(translatableObj, *partition, builder);
+    } else {
+        generator.visit(translatableObj, builder);
+    }
+}
 
+void CodeGenerator::setTarget(llvm::Module &mod) {
     // MacOS specific code. This is needed, since the default Triple will have the
     // OS as darwin, but the clang will expect the os as macosx
     llvm::Triple triple(LLVM_DEFAULT_TARGET_TRIPLE);
@@ -50,20 +88,291 @@ int CodeGenerator::generateLLVMIR(Package &translatableObj, const std::string &o
 
     mod.setDataLayout("e-m:e-i64:64-f80:128-n8:16:32:64-S128");
     mod.setTargetTriple(tripleString);
+}
 
-    // Codegen
-    PackageCodeGen generator(mod);
-    generator.visit(translatableObj, builder);
+// Runs the default new pass manager pipeline for the level. Scalar locals
+// are split early with SROA and the int_to_any/any_to_int helpers (marked
+// always inline) are inlined before the main simplification passes run.
+// With thinLTOBitcode the ThinLTO pre-link pipeline is used instead, and the
+// module is written there as bitcode with its summary index. The cost model
+// of targetMachine drives the vectorizers and unrolling, as in clang.
+void CodeGenerator::optimize(llvm::Module &mod, unsigned optLevel, llvm::TargetMachine *targetMachine,
+                             llvm::raw_ostream *thinLTOBitcode) {
+    if (optLevel == 0 && thinLTOBitcode == nullptr) {
+        return;
+    }
+    PhaseScope phase("Optimize");
+    llvm::PassBuilder passBuilder(targetMachine);
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager cgsccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+    // Registered before the defaults, which would not know the library
+    // functions of the triple
+    llvm::TargetLibraryInfoImpl libraryInfo(llvm::Triple(mod.getTargetTriple()));
+    functionAnalyses.registerPass([&libraryInfo] { return llvm::TargetLibraryAnalysis(libraryInfo); });
+    passBuilder.registerModuleAnalyses(moduleAnalyses);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalyses);
+    passBuilder.registerFunctionAnalyses(functionAnalyses);
+    passBuilder.registerLoopAnalyses(loopAnalyses);
+    passBuilder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+
+    passBuilder.registerPipelineStartEPCallback([](llvm::ModulePassManager &modulePasses) {
+        modulePasses.addPass(llvm::createModuleToFunctionPassAdaptor(llvm::SROA()));
+        modulePasses.addPass(llvm::AlwaysInlinerPass());
+    });
+
+    llvm::ModulePassManager modulePasses;
+    if (optLevel > 0) {
+        llvm::PassBuilder::OptimizationLevel level = llvm::PassBuilder::OptimizationLevel::O2;
+        if (optLevel == 1) {
+            level = llvm::PassBuilder::OptimizationLevel::O1;
+        } else if (optLevel >= 3) {
+            level = llvm::PassBuilder::OptimizationLevel::O3;
+        }
+        modulePasses = (thinLTOBitcode != nullptr) ? passBuilder.buildThinLTOPreLinkDefaultPipeline(level)
+                                                   : passBuilder.buildPerModuleDefaultPipeline(level);
+    }
+    if (thinLTOBitcode != nullptr) {
+        modulePasses.addPass(llvm::ThinLTOBitcodeWriterPass(*thinLTOBitcode, nullptr));
+    }
+    modulePasses.run(mod, moduleAnalyses);
+}
+
+void CodeGenerator::initializeNativeTarget() {
+    // Batch mode creates target machines from several threads
+    static std::once_flag targetInitialized;
+    std::call_once(targetInitialized, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+    });
+}
+
+std::unique_ptr<llvm::TargetMachine> CodeGenerator::createTargetMachine(const llvm::Module &mod, unsigned optLevel,
+                                                                        std::string &errorMessage) {
+    initializeNativeTarget();
+
+    const auto &triple = mod.getTargetTriple();
+    const auto *target = llvm::TargetRegistry::lookupTarget(triple, errorMessage);
+    if (target == nullptr) {
+        return nullptr;
+    }
+    auto codeGenLevel = llvm::CodeGenOpt::Default;
+    if (optLevel == 0) {
+        codeGenLevel = llvm::CodeGenOpt::None;
+    } else if (optLevel == 1) {
+        codeGenLevel = llvm::CodeGenOpt::Less;
+    } else if (optLevel >= 3) {
+        codeGenLevel = llvm::CodeGenOpt::Aggressive;
+    }
+    // Objects are linked by clang, which produces position independent
+    // executables by default
+    return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(
+        triple, "generic", "", llvm::TargetOptions(), llvm::Reloc::PIC_, llvm::None, codeGenLevel));
+}
+
+int CodeGenerator::generateLLVMIR(Package &translatableObj, const std::string &outFileName,
+                                  llvm::LLVMContext &mContext, const CodeGenOptions &options) {
+    auto mod = llvm::Module(translatableObj.getModuleName(), mContext);
+    translate(translatableObj, mod);
+    return writeModule(mod, outFileName, options);
+}
+
+// The caller decodes the bodies, typically on another thread, while the
+// functions handed out so far are lowered here. Only the functions queued
+// between the two hold a decoded body at any time.
+int CodeGenerator::generateStreamed(Package &translatableObj, const std::function<Function *()> &nextFunction,
+                                    const std::string &outFileName, const CodeGenOptions &options) {
+    llvm::LLVMContext mContext;
+    auto mod = llvm::Module(translatableObj.getModuleName(), mContext);
+    {
+        PhaseScope phase("Translate");
+        auto builder = llvm::IRBuilder<>(mContext);
+        setTarget(mod);
+        PackageCodeGen generator(mod);
+        generator.visit(translatableObj, nextFunction, builder);
+    }
+    return writeModule(mod, outFileName, options);
+}
+
+std::string CodeGenerator::partitionFileName(const std::string &outFileName, unsigned index) {
+    size_t extensionPos = outFileName.find_last_of("\\/.");
+    if (extensionPos == std::string::npos || outFileName[extensionPos] != '.') {
+        return outFileName + "." + std::to_string(index);
+    }
+    return outFileName.substr(0, extensionPos) + "." + std::to_string(index) + outFileName.substr(extensionPos);
+}
+
+// Each partition is translated, optimized and written on its own thread and
+// LLVMContext. Calls between partitions go through external declarations,
+// which the linker resolves.
+int CodeGenerator::generatePartitions(Package &translatableObj, const std::string &outFileName,
+                                      const CodeGenOptions &options) {
+    if (outFileName == "-") {
+        std::cerr << "Partitioned modules can not be written to stdout" << std::endl;
+        return -1;
+    }
+    auto partitions = PackageCodeGen::partition(translatableObj, options.partitions);
+    std::vector<int> results(partitions.size(), 0);
+    std::vector<std::thread> workers;
+    workers.reserve(partitions.size());
+    for (unsigned i = 0; i < partitions.size(); i++) {
+        workers.emplace_back([&, i]() {
+            TraceThreadScope traceThread;
+            llvm::LLVMContext mContext;
+            auto mod = llvm::Module(translatableObj.getModuleName() + "." + std::to_string(i), mContext);
+            translate(translatableObj, mod, &partitions[i]);
+            results[i] = writeModule(mod, partitionFileName(outFileName, i), options);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    bool failed = std::any_of(results.begin(), results.end(), [](int result) { return result != 0; });
+    return failed ? -1 : 0;
+}
+
+// Every function with a body is its own partition, plus one for the global
+// variables. Fragments missing from the cache are generated on a pool of
+// threads, and written under a temporary name first so that builds sharing
+// the cache never pick up a partial file.
+int CodeGenerator::generateCached(Package &translatableObj, const std::string &responseFileName,
+                                  const CodeGenOptions &options, CacheStats &stats) {
+    FunctionCache cache(options.cacheDirectory, options);
+    if (!cache.open()) {
+        std::cerr << "Unable to create cache directory " << options.cacheDirectory << std::endl;
+        return -1;
+    }
+
+    std::vector<std::string> fragmentPaths;
+    std::vector<std::pair<std::string, ModulePartition>> missing;
+    auto addFragment = [&](std::string key, ModulePartition partition) {
+        fragmentPaths.push_back(cache.getFragmentPath(key));
+        if (cache.contains(key)) {
+            stats.hits++;
+            return;
+        }
+        stats.misses++;
+        missing.emplace_back(std::move(key), std::move(partition));
+    };
+    addFragment(cache.getGlobalsKey(translatableObj), ModulePartition{{}, true});
+    for (uint32_t i = 0; i < translatableObj.functions.size(); i++) {
+        const auto &function = translatableObj.functions[i];
+        if (!function.isExternalFunction()) {
+            addFragment(cache.getFunctionKey(translatableObj, function), ModulePartition{{i}, false});
+        }
+    }
+
+    unsigned workerCount = llvm::hardware_concurrency().compute_thread_count();
+    workerCount = std::max(1u, std::min<unsigned>(workerCount, missing.size()));
+    std::atomic<size_t> nextFragment{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < workerCount && !missing.empty(); w++) {
+        workers.emplace_back([&]() {
+            TraceThreadScope traceThread;
+            llvm::LLVMContext mContext;
+            for (size_t i = nextFragment++; i < missing.size(); i = nextFragment++) {
+                const auto &[key, partition] = missing[i];
+                auto mod = llvm::Module(translatableObj.getModuleName() + "." + key, mContext);
+                translate(translatableObj, mod, &partition);
+                auto fragmentPath = cache.getFragmentPath(key);
+                auto tempPath = fragmentPath + "." + std::to_string(llvm::sys::Process::getProcessId()) + ".tmp";
+                if (writeModule(mod, tempPath, options) != 0 || llvm::sys::fs::rename(tempPath, fragmentPath)) {
+                    std::cerr << "Unable to write " << fragmentPath << std::endl;
+                    failed = true;
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (failed) {
+        return -1;
+    }
 
-    // Write LLVM IR to file
     std::error_code EC;
-    auto outStream = llvm::raw_fd_ostream(outFileName, EC);
+    auto responseFile = llvm::raw_fd_ostream(responseFileName, EC, llvm::sys::fs::OF_Text);
     if (EC) {
         std::cerr << EC.message();
         return -1;
     }
-    mod.print(outStream, nullptr);
+    // Quoted for the GNU response file tokenizer, which only unescapes \ and ",
+    // so every other byte (e.g. of a UTF-8 path) is written as is
+    for (const auto &fragmentPath : fragmentPaths) {
+        responseFile << "\"";
+        for (char c : fragmentPath) {
+            if (c == '\\' || c == '"') {
+                responseFile << '\\';
+            }
+            responseFile << c;
+        }
+        responseFile << "\"\n";
+    }
     return 0;
 }
 
+int CodeGenerator::writeModule(llvm::Module &mod, const std::string &outFileName, const CodeGenOptions &options) {
+    // Needed to emit native code, and for the cost model of the optimizer
+    std::unique_ptr<llvm::TargetMachine> targetMachine;
+    if (options.outputKind != OUTPUT_KIND_LLVM_IR || options.optLevel > 0) {
+        std::string errorMessage;
+        targetMachine = createTargetMachine(mod, options.optLevel, errorMessage);
+        if (!targetMachine) {
+            std::cerr << errorMessage << std::endl;
+            return -1;
+        }
+        mod.setDataLayout(targetMachine->createDataLayout());
+    }
+
+    std::error_code EC;
+    bool isBinary = options.outputKind == OUTPUT_KIND_OBJECT || options.outputKind == OUTPUT_KIND_BITCODE;
+    auto outStream = llvm::raw_fd_ostream(outFileName, EC, isBinary ? llvm::sys::fs::OF_None : llvm::sys::fs::OF_Text);
+    if (EC) {
+        std::cerr << EC.message();
+        return -1;
+    }
+    bool isBitcode = options.outputKind == OUTPUT_KIND_BITCODE;
+    optimize(mod, options.optLevel, targetMachine.get(), isBitcode ? &outStream : nullptr);
+
+    // Write LLVM IR to file (bitcode was written by the pass pipeline)
+    if (options.outputKind == OUTPUT_KIND_LLVM_IR) {
+        PhaseScope phase("Write LLVM IR");
+        mod.print(outStream, nullptr);
+        return 0;
+    }
+    if (isBitcode) {
+        return 0;
+    }
+
+    // Or native code, straight from the in memory module
+    llvm::legacy::PassManager emitPasses;
+    auto fileType = options.outputKind == OUTPUT_KIND_OBJECT ? llvm::CGFT_ObjectFile : llvm::CGFT_AssemblyFile;
+    if (targetMachine->addPassesToEmitFile(emitPasses, outStream, nullptr, fileType)) {
+        std::cerr << "Target " << mod.getTargetTriple() << " can not emit this file type" << std::endl;
+        return -1;
+    }
+    PhaseScope phase("Emit native code");
+    emitPasses.run(mod);
+    return 0;
+}
+
+std::pair<double, double> CodeGenerator::measureThroughput(Package &translatableObj, unsigned iterations) {
+    std::chrono::duration<double> elapsed{0};
+    unsigned instructionCount = 0;
+    for (unsigned i = 0; i < iterations; i++) {
+        llvm::LLVMContext mContext;
+        auto mod = llvm::Module(translatableObj.getModuleName(), mContext);
+        auto start = std::chrono::steady_clock::now();
+        translate(translatableObj, mod);
+        elapsed += std::chrono::steady_clock::now() - start;
+        instructionCount = mod.getInstructionCount();
+    }
+    double seconds = elapsed.count();
+    double msPerIteration = seconds * 1000 / iterations;
+    double instructionsPerSecond = seconds > 0 ? (double)instructionCount * iterations / seconds : 0;
+    return {msPerIteration, instructionsPerSecond};
+}
+
 } // namespace nballerina
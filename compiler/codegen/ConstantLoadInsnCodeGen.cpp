@@ -46,27 +46,29 @@ void NonTerminatorInsnCodeGen::visit(ConstantLoadInsn &obj, llvm::IRBuilder<> &b
     }
     case TYPE_TAG_STRING:
     case TYPE_TAG_CHAR_STRING: {
-        std::string stringValue = std::get<std::string>(obj.value);
+        auto stringValue = std::get<std::string_view>(obj.value);
         llvm::Module &module = moduleGenerator.getModule();
-        llvm::Constant *llvmConst = llvm::ConstantDataArray::getString(module.getContext(), stringValue);
+        llvm::Constant *llvmConst =
+            llvm::ConstantDataArray::getString(module.getContext(), llvm::StringRef(stringValue));
         auto *globalStringValue = new llvm::GlobalVariable(module, llvmConst->getType(), false,
                                                            llvm::GlobalValue::PrivateLinkage, llvmConst, ".str");
         globalStringValue->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
         globalStringValue->setAlignment(llvm::Align(1));
         auto *valueRef = builder.CreateInBoundsGEP(
             globalStringValue, llvm::ArrayRef<llvm::Value *>({builder.getInt64(0), builder.getInt64(0)}), "simple");
-        auto addedStringRef = CodeGenUtils::getStringInitFunc(module);
+        auto addedStringRef = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_STRING_INIT);
         constRef = builder.CreateCall(
             addedStringRef, llvm::ArrayRef<llvm::Value *>({valueRef, builder.getInt64(stringValue.length())}));
         break;
     }
     case TYPE_TAG_NIL: {
-        const auto &lhsOpName = obj.lhsOp.getName();
+        auto lhsOpName = obj.lhsOp.getName();
         const auto &funcRef = obj.getFunctionRef();
         if (funcRef.isMainFunction() && (lhsOpName == funcRef.getReturnVar()->getName())) {
             return;
         }
-        constRef = builder.CreateLoad(CodeGenUtils::getGlobalNilVar(moduleGenerator.getModule()), lhsOpName + "_temp");
+        constRef = builder.CreateLoad(CodeGenUtils::getGlobalNilVar(moduleGenerator.getModule()),
+                                      llvm::StringRef(lhsOpName) + "_temp");
         break;
     }
     default:
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "codegen/FunctionCache.h"
+#include "bir/ArrayInstructions.h"
+#include "bir/BasicBlock.h"
+#include "bir/BinaryOpInsn.h"
+#include "bir/ConditionBrInsn.h"
+#include "bir/ConstantLoad.h"
+#include "bir/Function.h"
+#include "bir/FunctionCallInsn.h"
+#include "bir/MapInsns.h"
+#include "bir/MoveInsn.h"
+#include "bir/Package.h"
+#include "bir/StructureInsn.h"
+#include "bir/TypeCastInsn.h"
+#include "bir/UnaryOpInsn.h"
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <cstring>
+#include <variant>
+
+namespace nballerina {
+
+// Bump when the lowering changes, so that stale fragments are not reused
+static constexpr const char *FUNCTION_CACHE_VERSION = "nballerina-function-cache-1";
+
+FunctionCache::FunctionCache(std::string directory, const CodeGenOptions &options)
+    : directory(std::move(directory)), extension(getOutputExtension(options.outputKind)) {
+    llvm::MD5 hash;
+    hashString(hash, FUNCTION_CACHE_VERSION);
+    hashString(hash, LLVM_VERSION_STRING);
+    hashString(hash, LLVM_DEFAULT_TARGET_TRIPLE);
+    hashInteger(hash, options.optLevel);
+    hashInteger(hash, options.outputKind);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    optionsKey = std::string(result.digest());
+}
+
+bool FunctionCache::open() const { return !llvm::sys::fs::create_directories(directory); }
+
+// Strings are length prefixed so that adjacent fields can not run together
+void FunctionCache::hashString(llvm::MD5 &hash, std::string_view value) {
+    hashInteger(hash, value.size());
+    hash.update(llvm::StringRef(value.data(), value.size()));
+}
+
+void FunctionCache::hashInteger(llvm::MD5 &hash, uint64_t value) {
+    uint8_t bytes[sizeof(value)];
+    for (size_t i = 0; i < sizeof(value); i++) {
+        bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+    hash.update(llvm::ArrayRef<uint8_t>(bytes));
+}
+
+void FunctionCache::hashType(llvm::MD5 &hash, const Type &type) {
+    hashInteger(hash, type.getTypeTag());
+    hashString(hash, type.getName());
+    if (type.getTypeTag() == TYPE_TAG_ARRAY) {
+        const auto &arrayType = type.getArrayType();
+        hashInteger(hash, arrayType.memberType);
+        hashInteger(hash, arrayType.size);
+        hashInteger(hash, arrayType.state);
+    } else if (type.getTypeTag() == TYPE_TAG_MAP) {
+        hashInteger(hash, type.getMemberTypeTag());
+    }
+}
+
+// Locals are covered by the function, globals are hashed with their type
+// since it decides how they are loaded and stored
+void FunctionCache::hashOperand(llvm::MD5 &hash, const Package &package, const Operand &operand) {
+    hashInteger(hash, operand.getKind());
+    hashString(hash, operand.getName());
+    if (operand.getKind() == GLOBAL_VAR_KIND) {
+        hashType(hash, package.getGlobalVariable(operand.getName()).getType());
+    }
+}
+
+void FunctionCache::hashSignature(llvm::MD5 &hash, const Function &function) {
+    hashString(hash, function.getName());
+    hashInteger(hash, function.flags);
+    hashInteger(hash, function.getNumParams());
+    for (const auto &param : function.getParams()) {
+        hashType(hash, param.getType());
+    }
+    hashInteger(hash, function.getRestParam().has_value());
+    hashInteger(hash, function.getReturnVar().has_value());
+    if (function.getReturnVar()) {
+        hashType(hash, function.getReturnVar()->getType());
+    }
+}
+
+void FunctionCache::hashInstruction(llvm::MD5 &hash, const Package &package, const NonTerminatorInsn &insn) {
+    hashInteger(hash, insn.getKind());
+    switch (insn.getKind()) {
+    case INSTRUCTION_KIND_NEW_ARRAY: {
+        const auto &arrayInsn = static_cast<const ArrayInsn &>(insn);
+        hashOperand(hash, package, arrayInsn.lhsOp);
+        hashOperand(hash, package, arrayInsn.sizeOp);
+        break;
+    }
+    case INSTRUCTION_KIND_ARRAY_STORE: {
+        const auto &storeInsn = static_cast<const ArrayStoreInsn &>(insn);
+        hashOperand(hash, package, storeInsn.lhsOp);
+        hashOperand(hash, package, storeInsn.keyOp);
+        hashOperand(hash, package, storeInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_ARRAY_LOAD: {
+        const auto &loadInsn = static_cast<const ArrayLoadInsn &>(insn);
+        hashOperand(hash, package, loadInsn.lhsOp);
+        hashOperand(hash, package, loadInsn.keyOp);
+        hashOperand(hash, package, loadInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_BINARY_ADD:
+    case INSTRUCTION_KIND_BINARY_SUB:
+    case INSTRUCTION_KIND_BINARY_MUL:
+    case INSTRUCTION_KIND_BINARY_DIV:
+    case INSTRUCTION_KIND_BINARY_MOD:
+    case INSTRUCTION_KIND_BINARY_EQUAL:
+    case INSTRUCTION_KIND_BINARY_NOT_EQUAL:
+    case INSTRUCTION_KIND_BINARY_GREATER_THAN:
+    case INSTRUCTION_KIND_BINARY_GREATER_EQUAL:
+    case INSTRUCTION_KIND_BINARY_LESS_THAN:
+    case INSTRUCTION_KIND_BINARY_LESS_EQUAL:
+    case INSTRUCTION_KIND_BINARY_BITWISE_XOR: {
+        const auto &binaryInsn = static_cast<const BinaryOpInsn &>(insn);
+        hashOperand(hash, package, binaryInsn.lhsOp);
+        hashOperand(hash, package, binaryInsn.rhsOp1);
+        hashOperand(hash, package, binaryInsn.rhsOp2);
+        break;
+    }
+    case INSTRUCTION_KIND_CONST_LOAD: {
+        const auto &constInsn = static_cast<const ConstantLoadInsn &>(insn);
+        hashOperand(hash, package, constInsn.lhsOp);
+        hashInteger(hash, constInsn.typeTag);
+        hashInteger(hash, constInsn.value.index());
+        if (const auto *intValue = std::get_if<int64_t>(&constInsn.value)) {
+            hashInteger(hash, *intValue);
+        } else if (const auto *doubleValue = std::get_if<double>(&constInsn.value)) {
+            uint64_t bits = 0;
+            static_assert(sizeof(bits) == sizeof(*doubleValue));
+            std::memcpy(&bits, doubleValue, sizeof(bits));
+            hashInteger(hash, bits);
+        } else if (const auto *boolValue = std::get_if<bool>(&constInsn.value)) {
+            hashInteger(hash, *boolValue);
+        } else {
+            hashString(hash, std::get<std::string_view>(constInsn.value));
+        }
+        break;
+    }
+    case INSTRUCTION_KIND_MAP_LOAD: {
+        const auto &loadInsn = static_cast<const MapLoadInsn &>(insn);
+        hashOperand(hash, package, loadInsn.lhsOp);
+        hashOperand(hash, package, loadInsn.keyOp);
+        hashOperand(hash, package, loadInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_MAP_STORE: {
+        const auto &storeInsn = static_cast<const MapStoreInsn &>(insn);
+        hashOperand(hash, package, storeInsn.lhsOp);
+        hashOperand(hash, package, storeInsn.keyOp);
+        hashOperand(hash, package, storeInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_MOVE: {
+        const auto &moveInsn = static_cast<const MoveInsn &>(insn);
+        hashOperand(hash, package, moveInsn.lhsOp);
+        hashOperand(hash, package, moveInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_NEW_STRUCTURE: {
+        const auto &structureInsn = static_cast<const StructureInsn &>(insn);
+        hashOperand(hash, package, structureInsn.lhsOp);
+        hashInteger(hash, structureInsn.initValues.size());
+        for (const auto &initValue : structureInsn.initValues) {
+            hashInteger(hash, initValue.getKind());
+            if (const auto *keyValue = std::get_if<MapConstruct::KeyValue>(&initValue.getInitValStruct())) {
+                hashOperand(hash, package, keyValue->getKey());
+                hashOperand(hash, package, keyValue->getValue());
+            } else {
+                hashOperand(hash, package, std::get<MapConstruct::SpreadField>(initValue.getInitValStruct()).getExpr());
+            }
+        }
+        break;
+    }
+    case INSTRUCTION_KIND_TYPE_CAST: {
+        const auto &castInsn = static_cast<const TypeCastInsn &>(insn);
+        hashOperand(hash, package, castInsn.lhsOp);
+        hashOperand(hash, package, castInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_UNARY_NEG:
+    case INSTRUCTION_KIND_UNARY_NOT: {
+        const auto &unaryInsn = static_cast<const UnaryOpInsn &>(insn);
+        hashOperand(hash, package, unaryInsn.lhsOp);
+        hashOperand(hash, package, unaryInsn.rhsOp);
+        break;
+    }
+    default:
+        llvm_unreachable("Unsupported non terminator instruction");
+    }
+}
+
+void FunctionCache::hashTerminator(llvm::MD5 &hash, const Package &package, const TerminatorInsn &insn) {
+    hashInteger(hash, insn.getKind());
+    hashString(hash, insn.getThenBBID());
+    switch (insn.getKind()) {
+    case INSTRUCTION_KIND_CONDITIONAL_BRANCH: {
+        const auto &branchInsn = static_cast<const ConditionBrInsn &>(insn);
+        hashOperand(hash, package, branchInsn.lhsOp);
+        hashString(hash, branchInsn.getElseBBID());
+        break;
+    }
+    case INSTRUCTION_KIND_CALL: {
+        // The call is lowered against the callee declaration, so its
+        // signature is part of the caller
+        const auto &callInsn = static_cast<const FunctionCallInsn &>(insn);
+        hashOperand(hash, package, callInsn.lhsOp);
+        hashInteger(hash, callInsn.argsList.size());
+        for (const auto &arg : callInsn.argsList) {
+            hashOperand(hash, package, arg);
+        }
+        hashSignature(hash, package.getFunction(callInsn.getFunctionName()));
+        break;
+    }
+    case INSTRUCTION_KIND_GOTO:
+    case INSTRUCTION_KIND_RETURN:
+        break;
+    default:
+        llvm_unreachable("Unsupported terminator instruction");
+    }
+}
+
+std::string FunctionCache::finalizeKey(llvm::MD5 &hash) const {
+    hashString(hash, optionsKey);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    return std::string(result.digest());
+}
+
+std::string FunctionCache::getFunctionKey(const Package &package, const Function &function) const {
+    llvm::MD5 hash;
+    hashSignature(hash, function);
+    hashInteger(hash, function.localVars.size());
+    for (const auto &localVar : function.localVars) {
+        hashInteger(hash, localVar.getKind());
+        hashString(hash, localVar.getName());
+        hashType(hash, localVar.getType());
+    }
+    hashInteger(hash, function.basicBlocks.size());
+    for (const auto *basicBlock : function.basicBlocks) {
+        hashString(hash, basicBlock->getId());
+        hashInteger(hash, basicBlock->instructions.size());
+        for (const auto *insn : basicBlock->instructions) {
+            hashInstruction(hash, package, *insn);
+        }
+        const auto *terminator = basicBlock->getTerminatorInsnPtr();
+        hashInteger(hash, terminator != nullptr);
+        if (terminator != nullptr) {
+            hashTerminator(hash, package, *terminator);
+        }
+    }
+    return finalizeKey(hash);
+}
+
+std::string FunctionCache::getGlobalsKey(const Package &package) const {
+    llvm::MD5 hash;
+    hashString(hash, "globals");
+    hashInteger(hash, package.globalVars.size());
+    for (const auto &globalVar : package.globalVars) {
+        hashString(hash, globalVar.getName());
+        hashType(hash, globalVar.getType());
+    }
+    return finalizeKey(hash);
+}
+
+std::string FunctionCache::getFragmentPath(const std::string &key) const {
+    llvm::SmallString<256> path(directory);
+    llvm::sys::path::append(path, key + extension);
+    return std::string(path);
+}
+
+bool FunctionCache::contains(const std::string &key) const { return llvm::sys::fs::exists(getFragmentPath(key)); }
+
+} // namespace nballerina
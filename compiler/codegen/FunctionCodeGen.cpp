@@ -29,14 +29,18 @@ namespace nballerina {
 FunctionCodeGen::FunctionCodeGen(PackageCodeGen &parentGenerator)
     : parentGenerator(parentGenerator), llvmFunction(nullptr) {}
 
-llvm::BasicBlock *FunctionCodeGen::getBasicBlock(const std::string &id) { return basicBlocksMap[id]; }
+llvm::BasicBlock *FunctionCodeGen::getBasicBlock(uint32_t index) const {
+    if (index >= basicBlocks.size()) {
+        return nullptr;
+    }
+    return basicBlocks[index];
+}
 
-llvm::AllocaInst *FunctionCodeGen::getLocalVal(const std::string &varName) const {
-    const auto &varIt = localVarRefs.find(varName);
-    if (varIt == localVarRefs.end()) {
+llvm::AllocaInst *FunctionCodeGen::getLocalVal(uint32_t index) const {
+    if (index >= localVarRefs.size()) {
         return nullptr;
     }
-    return varIt->second;
+    return localVarRefs[index];
 }
 
 llvm::Type *FunctionCodeGen::getRetValType(const Function &obj, llvm::Module &module) {
@@ -49,16 +53,25 @@ llvm::Type *FunctionCodeGen::getRetValType(const Function &obj, llvm::Module &mo
 
 llvm::Value *FunctionCodeGen::createTempVal(const Operand &operand, llvm::IRBuilder<> &builder) const {
     auto *variable = getLocalOrGlobalVal(operand);
-    return builder.CreateLoad(variable, operand.getName() + "_temp");
+    return builder.CreateLoad(variable, llvm::StringRef(operand.getName()) + "_temp");
 }
 
 llvm::Value *FunctionCodeGen::getLocalOrGlobalVal(const Operand &op) const {
     if (op.getKind() == GLOBAL_VAR_KIND) {
-        auto *variable = parentGenerator.getModule().getGlobalVariable(op.getName(), false);
+        auto *variable = parentGenerator.getGlobalVariable(op.getIndex());
+        if (variable == nullptr) {
+            variable = parentGenerator.getModule().getGlobalVariable(op.getName(), false);
+        }
         assert(variable != nullptr);
         return variable;
     }
-    return getLocalVal(op.getName());
+    return getLocalVal(op.getIndex());
+}
+
+llvm::AllocaInst *FunctionCodeGen::createEntryAlloca(llvm::Type *type, const llvm::Twine &name) {
+    auto &entryBB = llvmFunction->getEntryBlock();
+    llvm::IRBuilder<> entryBuilder(&entryBB, entryBB.begin());
+    return entryBuilder.CreateAlloca(type, nullptr, name);
 }
 
 llvm::Function *FunctionCodeGen::getFunctionValue() { return llvmFunction; }
@@ -72,37 +85,44 @@ void FunctionCodeGen::visit(Function &obj, llvm::IRBuilder<> &builder) {
 
     // iterate through all local vars.
     size_t paramIndex = 0;
+    localVarRefs.reserve(obj.localVars.size());
     for (auto const &locVar : obj.localVars) {
-        auto *varType = CodeGenUtils::getLLVMTypeOfType(locVar.getType(), module);
-        auto *localVarRef = builder.CreateAlloca(varType, nullptr, locVar.getName());
-        localVarRefs.insert({locVar.getName(), localVarRef});
+        auto *varType = parentGenerator.getLLVMType(locVar.getType());
+        auto *localVarRef = builder.CreateAlloca(varType, nullptr, llvm::StringRef(locVar.getName()));
+        localVarRefs.push_back(localVarRef);
 
         if (locVar.isParamter()) {
             llvm::Argument *parmRef = &(llvmFunction->arg_begin()[paramIndex]);
             auto paramName = obj.requiredParams[paramIndex].getName();
-            parmRef->setName(paramName);
+            parmRef->setName(llvm::StringRef(paramName));
             builder.CreateStore(parmRef, localVarRef);
             paramIndex++;
         }
     }
 
     // iterate through with each basic block in the function and create them
-    for (auto &bb : obj.basicBlocks) {
-        basicBlocksMap[bb.getId()] = llvm::BasicBlock::Create(module.getContext(), bb.getId(), llvmFunction);
+    basicBlocks.reserve(obj.basicBlocks.size());
+    for (auto *bb : obj.basicBlocks) {
+        auto *llvmBB = llvm::BasicBlock::Create(module.getContext(), llvm::StringRef(bb->getId()), llvmFunction);
+        basicBlocks.push_back(llvmBB);
     }
 
     // creating branch to next basic block.
-    if (!obj.basicBlocks.empty()) {
-        builder.CreateBr(basicBlocksMap[obj.basicBlocks[0].getId()]);
+    if (!basicBlocks.empty()) {
+        builder.CreateBr(basicBlocks[0]);
     }
 
     // Now translate the basic blocks (essentially add the instructions in them)
-    for (auto &bb : obj.basicBlocks) {
-        builder.SetInsertPoint(basicBlocksMap[bb.getId()]);
-        BasicBlockCodeGen generator(*this, parentGenerator);
-        generator.visit(bb, builder);
+    BasicBlockCodeGen generator(*this, parentGenerator);
+    for (size_t i = 0; i < obj.basicBlocks.size(); i++) {
+        builder.SetInsertPoint(basicBlocks[i]);
+        generator.visit(*obj.basicBlocks[i], builder);
     }
 
+    // Locals whose address never escapes become SSA values
+    CodeGenUtils::promoteStackSlots(*llvmFunction);
+    localVarRefs.clear();
+
     assert(!llvm::verifyFunction(*llvmFunction, &llvm::outs()));
 }
 
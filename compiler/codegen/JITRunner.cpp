@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "codegen/JITRunner.h"
+#include "bir/Package.h"
+#include "codegen/CodeGenerator.h"
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+#include <llvm/Object/Archive.h>
+#include <llvm/Object/SymbolSize.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/raw_ostream.h>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace nballerina {
+
+// Appends "<start> <size> <name>" for every JIT compiled function to
+// /tmp/perf-<pid>.map, which perf reads to symbolize samples in code that
+// has no backing file
+class PerfMapListener : public llvm::JITEventListener {
+  private:
+    std::mutex mapLock;
+    std::unique_ptr<llvm::raw_fd_ostream> mapFile;
+
+  public:
+    PerfMapListener() {
+        std::error_code EC;
+        auto mapFileName = "/tmp/perf-" + std::to_string(llvm::sys::Process::getProcessId()) + ".map";
+        mapFile = std::make_unique<llvm::raw_fd_ostream>(mapFileName, EC, llvm::sys::fs::OF_Text);
+        if (EC) {
+            std::cerr << "Unable to write " << mapFileName << ": " << EC.message() << std::endl;
+            mapFile.reset();
+        }
+    }
+
+    void notifyObjectLoaded(ObjectKey, const llvm::object::ObjectFile &obj,
+                            const llvm::RuntimeDyld::LoadedObjectInfo &loadedInfo) override {
+        if (!mapFile) {
+            return;
+        }
+        // The debug object has its sections moved to their load addresses
+        auto debugObj = loadedInfo.getObjectForDebug(obj);
+        const auto &loadedObj = debugObj.getBinary() ? *debugObj.getBinary() : obj;
+        std::lock_guard<std::mutex> lock(mapLock);
+        for (const auto &[symbol, size] : llvm::object::computeSymbolSizes(loadedObj)) {
+            auto type = symbol.getType();
+            auto name = symbol.getName();
+            auto address = symbol.getAddress();
+            if (!type || !name || !address || *type != llvm::object::SymbolRef::ST_Function || size == 0) {
+                llvm::consumeError(type.takeError());
+                llvm::consumeError(name.takeError());
+                llvm::consumeError(address.takeError());
+                continue;
+            }
+            *mapFile << llvm::format_hex_no_prefix(*address, 1) << " " << llvm::format_hex_no_prefix(size, 1) << " "
+                     << *name << "\n";
+        }
+        mapFile->flush();
+    }
+};
+
+// The runtime archives are built for LTO, so members are a mix of LLVM
+// bitcode and native objects. Each member is added to the JIT, which only
+// materializes the ones that define a symbol the module looks up.
+static llvm::Error addRuntimeArchive(llvm::orc::LLJIT &jit, const std::string &path,
+                                     llvm::orc::ThreadSafeContext &tsContext) {
+    auto archiveBuffer = llvm::MemoryBuffer::getFile(path);
+    if (!archiveBuffer) {
+        return llvm::createFileError(path, archiveBuffer.getError());
+    }
+    auto archive = llvm::object::Archive::create((*archiveBuffer)->getMemBufferRef());
+    if (!archive) {
+        return archive.takeError();
+    }
+    llvm::Error err = llvm::Error::success();
+    for (const auto &child : (*archive)->children(err)) {
+        auto memberBuffer = child.getMemoryBufferRef();
+        if (!memberBuffer) {
+            return memberBuffer.takeError();
+        }
+        auto magic = llvm::identify_magic(memberBuffer->getBuffer());
+        if (magic == llvm::file_magic::bitcode) {
+            auto lock = tsContext.getLock();
+            auto member = llvm::parseBitcodeFile(*memberBuffer, *tsContext.getContext());
+            if (!member) {
+                return member.takeError();
+            }
+            if (auto addErr = jit.addIRModule(llvm::orc::ThreadSafeModule(std::move(*member), tsContext))) {
+                return addErr;
+            }
+        } else if (magic == llvm::file_magic::elf_relocatable || magic == llvm::file_magic::macho_object ||
+                   magic == llvm::file_magic::coff_object) {
+            if (auto addErr = jit.addObjectFile(llvm::MemoryBuffer::getMemBufferCopy(
+                    memberBuffer->getBuffer(), memberBuffer->getBufferIdentifier()))) {
+                return addErr;
+            }
+        }
+    }
+    return err;
+}
+
+int JITRunner::run(Package &translatableObj, const CodeGenOptions &options) {
+    CodeGenerator::initializeNativeTarget();
+
+    llvm::orc::LLJITBuilder jitBuilder;
+    jitBuilder.setObjectLinkingLayerCreator([&](llvm::orc::ExecutionSession &session, const llvm::Triple &) {
+        auto objectLayer = std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(
+            session, []() { return std::make_unique<llvm::SectionMemoryManager>(); });
+        if (options.perfMap) {
+            // jitdump records for `perf inject --jit`, when LLVM was built
+            // with perf support
+            if (auto *jitDumpListener = llvm::JITEventListener::createPerfJITEventListener()) {
+                objectLayer->registerJITEventListener(*jitDumpListener);
+            }
+            static PerfMapListener perfMapListener;
+            objectLayer->registerJITEventListener(perfMapListener);
+        }
+        return std::unique_ptr<llvm::orc::ObjectLayer>(std::move(objectLayer));
+    });
+    auto jit = jitBuilder.create();
+    if (!jit) {
+        std::cerr << llvm::toString(jit.takeError()) << std::endl;
+        return -1;
+    }
+
+    // Symbols the runtime archives leave undefined (libc, libpthread, ...)
+    // come from this process
+    auto &mainDylib = (*jit)->getMainJITDylib();
+    auto processSymbols =
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess((*jit)->getDataLayout().getGlobalPrefix());
+    if (!processSymbols) {
+        std::cerr << llvm::toString(processSymbols.takeError()) << std::endl;
+        return -1;
+    }
+    mainDylib.addGenerator(std::move(*processSymbols));
+
+    llvm::orc::ThreadSafeContext tsContext(std::make_unique<llvm::LLVMContext>());
+    for (const auto &runtimeLibrary : options.runtimeLibraries) {
+        if (auto err = addRuntimeArchive(**jit, runtimeLibrary, tsContext)) {
+            std::cerr << runtimeLibrary << ": " << llvm::toString(std::move(err)) << std::endl;
+            return -1;
+        }
+    }
+
+    {
+        auto lock = tsContext.getLock();
+        auto mod = std::make_unique<llvm::Module>(translatableObj.getModuleName(), *tsContext.getContext());
+        CodeGenerator::translate(translatableObj, *mod);
+        mod->setTargetTriple((*jit)->getTargetTriple().str());
+        mod->setDataLayout((*jit)->getDataLayout());
+        // The host machine the JIT compiles for, as the optimizer's cost model
+        std::unique_ptr<llvm::TargetMachine> targetMachine;
+        if (options.optLevel > 0) {
+            auto machineBuilder = llvm::orc::JITTargetMachineBuilder::detectHost();
+            if (!machineBuilder) {
+                std::cerr << llvm::toString(machineBuilder.takeError()) << std::endl;
+                return -1;
+            }
+            auto machine = machineBuilder->createTargetMachine();
+            if (!machine) {
+                std::cerr << llvm::toString(machine.takeError()) << std::endl;
+                return -1;
+            }
+            targetMachine = std::move(*machine);
+        }
+        CodeGenerator::optimize(*mod, options.optLevel, targetMachine.get(), nullptr);
+        if (auto err = (*jit)->addIRModule(llvm::orc::ThreadSafeModule(std::move(mod), tsContext))) {
+            std::cerr << llvm::toString(std::move(err)) << std::endl;
+            return -1;
+        }
+    }
+
+    if (auto err = (*jit)->initialize(mainDylib)) {
+        std::cerr << llvm::toString(std::move(err)) << std::endl;
+        return -1;
+    }
+    auto mainSymbol = (*jit)->lookup("main");
+    if (!mainSymbol) {
+        std::cerr << llvm::toString(mainSymbol.takeError()) << std::endl;
+        return -1;
+    }
+    // Ballerina main takes no arguments and returns nothing; a panic exits
+    // the process from the runtime
+    auto *mainFunction = llvm::jitTargetAddressToFunction<void (*)()>(mainSymbol->getAddress());
+    mainFunction();
+    if (auto err = (*jit)->deinitialize(mainDylib)) {
+        std::cerr << llvm::toString(std::move(err)) << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace nballerina
@@ -31,7 +31,7 @@ void NonTerminatorInsnCodeGen::visit(MapStoreInsn &obj, llvm::IRBuilder<> &build
     auto memberTypeTag = lhsVar.getType().getMemberTypeTag();
     Type::checkMapSupport(memberTypeTag);
     llvm::Value *mapValue = functionGenerator.createTempVal(obj.rhsOp, builder);
-    builder.CreateCall(CodeGenUtils::getMapStoreFunc(moduleGenerator.getModule()),
+    builder.CreateCall(moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_MAP_STORE),
                        llvm::ArrayRef<llvm::Value *>({functionGenerator.createTempVal(obj.lhsOp, builder),
                                                       functionGenerator.createTempVal(obj.keyOp, builder), mapValue}));
 }
@@ -41,10 +41,10 @@ void NonTerminatorInsnCodeGen::visit(MapLoadInsn &obj, llvm::IRBuilder<> &builde
     auto *outParamType = CodeGenUtils::getLLVMTypeOfType(memTypeTag, moduleGenerator.getModule());
 
     auto *lhs = functionGenerator.getLocalOrGlobalVal(obj.lhsOp);
-    auto *outParam = builder.CreateAlloca(outParamType);
+    auto *outParam = functionGenerator.createEntryAlloca(outParamType, "map_load_out");
     auto *rhsTemp = functionGenerator.createTempVal(obj.rhsOp, builder);
     auto *keyTemp = functionGenerator.createTempVal(obj.keyOp, builder);
-    auto mapLoadFunction = CodeGenUtils::getMapLoadFunc(moduleGenerator.getModule());
+    auto mapLoadFunction = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_MAP_LOAD);
 
     [[maybe_unused]] auto *retVal =
         builder.CreateCall(mapLoadFunction, llvm::ArrayRef<llvm::Value *>({rhsTemp, keyTemp, outParam}));
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "codegen/NonTerminatorInsnCodeGen.h"
+#include "bir/ArrayInstructions.h"
+#include "bir/BinaryOpInsn.h"
+#include "bir/ConstantLoad.h"
+#include "bir/MapInsns.h"
+#include "bir/MoveInsn.h"
+#include "bir/StructureInsn.h"
+#include "bir/TypeCastInsn.h"
+#include "bir/UnaryOpInsn.h"
+
+namespace nballerina {
+
+void NonTerminatorInsnCodeGen::visit(NonTerminatorInsn &obj, llvm::IRBuilder<> &builder) {
+    switch (obj.getKind()) {
+    case INSTRUCTION_KIND_NEW_ARRAY:
+        visit(static_cast<ArrayInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_ARRAY_STORE:
+        visit(static_cast<ArrayStoreInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_ARRAY_LOAD:
+        visit(static_cast<ArrayLoadInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_BINARY_ADD:
+    case INSTRUCTION_KIND_BINARY_SUB:
+    case INSTRUCTION_KIND_BINARY_MUL:
+    case INSTRUCTION_KIND_BINARY_DIV:
+    case INSTRUCTION_KIND_BINARY_MOD:
+    case INSTRUCTION_KIND_BINARY_EQUAL:
+    case INSTRUCTION_KIND_BINARY_NOT_EQUAL:
+    case INSTRUCTION_KIND_BINARY_GREATER_THAN:
+    case INSTRUCTION_KIND_BINARY_GREATER_EQUAL:
+    case INSTRUCTION_KIND_BINARY_LESS_THAN:
+    case INSTRUCTION_KIND_BINARY_LESS_EQUAL:
+    case INSTRUCTION_KIND_BINARY_BITWISE_XOR:
+        visit(static_cast<BinaryOpInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_CONST_LOAD:
+        visit(static_cast<ConstantLoadInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_MAP_LOAD:
+        visit(static_cast<MapLoadInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_MAP_STORE:
+        visit(static_cast<MapStoreInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_MOVE:
+        visit(static_cast<MoveInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_NEW_STRUCTURE:
+        visit(static_cast<StructureInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_TYPE_CAST:
+        visit(static_cast<TypeCastInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_UNARY_NEG:
+    case INSTRUCTION_KIND_UNARY_NOT:
+        visit(static_cast<UnaryOpInsn &>(obj), builder);
+        break;
+    default:
+        llvm_unreachable("Unsupported non terminator instruction");
+    }
+}
+
+} // namespace nballerina
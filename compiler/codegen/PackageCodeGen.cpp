@@ -17,11 +17,15 @@
  */
 
 #include "codegen/PackageCodeGen.h"
+#include "bir/CompilerStats.h"
 #include "bir/FunctionParam.h"
 #include "bir/Package.h"
 #include "codegen/CodeGenUtils.h"
 #include "codegen/FunctionCodeGen.h"
 #include <llvm/IR/Verifier.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
 
 namespace nballerina {
 
@@ -30,9 +34,48 @@ PackageCodeGen::PackageCodeGen(llvm::Module &module)
 
 llvm::Module &PackageCodeGen::getModule() { return module; }
 
-void PackageCodeGen::visit(Package &obj, llvm::IRBuilder<> &builder) {
+void PackageCodeGen::visit(Package &obj, llvm::IRBuilder<> &builder) { visit(obj, nullptr, builder); }
+
+void PackageCodeGen::visit(Package &obj, const ModulePartition &partition, llvm::IRBuilder<> &builder) {
+    visit(obj, &partition, builder);
+}
+
+void PackageCodeGen::visit(Package &obj, const std::function<Function *()> &nextFunction,
+                           llvm::IRBuilder<> &builder) {
+    declarePackage(obj, nullptr, builder);
+    while (auto *function = nextFunction()) {
+        if (!function->isExternalFunction()) {
+            lowerFunction(*function, builder);
+        }
+        function->releaseBody();
+    }
+    finalizeModule(builder);
+}
+
+void PackageCodeGen::visit(Package &obj, const ModulePartition *partition, llvm::IRBuilder<> &builder) {
+    declarePackage(obj, partition, builder);
+
+    // iterating over each function translate the function body
+    if (partition == nullptr) {
+        for (auto &function : obj.functions) {
+            if (function.isExternalFunction()) {
+                continue;
+            }
+            lowerFunction(function, builder);
+        }
+    } else {
+        for (auto functionIndex : partition->functionIndices) {
+            lowerFunction(obj.functions[functionIndex], builder);
+        }
+    }
+
+    finalizeModule(builder);
+}
+
+void PackageCodeGen::declarePackage(Package &obj, const ModulePartition *partition, llvm::IRBuilder<> &builder) {
 
     module.setSourceFileName(obj.sourceFileName);
+    llvmTypes.assign(obj.getTypeTable().size(), nullptr);
 
     llvm::Type *charPtrType = builder.getInt8PtrTy();
     llvm::Constant *nullValue = llvm::Constant::getNullValue(charPtrType);
@@ -45,41 +88,48 @@ void PackageCodeGen::visit(Package &obj, llvm::IRBuilder<> &builder) {
                                               STRING_TABLE_NAME, nullptr);
     globalStrTable->setAlignment(llvm::Align(4));
 
-    // iterate over all global variables and translate
+    // iterate over all global variables and translate. Only one partition
+    // defines them, the others refer to them through declarations.
+    bool definesGlobals = partition == nullptr || partition->definesGlobals;
+    globalVarRefs.reserve(obj.globalVars.size());
     for (auto const &globVar : obj.globalVars) {
-        auto *varTyperef = CodeGenUtils::getLLVMTypeOfType(globVar.getType(), module);
-        llvm::Constant *initValue = llvm::Constant::getNullValue(varTyperef);
+        auto *varTyperef = getLLVMType(globVar.getType());
+        llvm::Constant *initValue = definesGlobals ? llvm::Constant::getNullValue(varTyperef) : nullptr;
         auto *gVar = new llvm::GlobalVariable(module, varTyperef, false, llvm::GlobalValue::ExternalLinkage, initValue,
-                                              globVar.getName(), nullptr);
+                                              llvm::StringRef(globVar.getName()), nullptr);
         gVar->setAlignment(llvm::Align(4));
+        globalVarRefs.push_back(gVar);
     }
 
     // iterating over each function, first create function definition
-    // (without function body) and adding to Module.
-    for (const auto &function : obj.functions) {
-        auto numParams = function.getNumParams();
-        std::vector<llvm::Type *> paramTypes;
-        paramTypes.reserve(numParams);
-        for (const auto &funcParam : function.getParams()) {
-            paramTypes.push_back(CodeGenUtils::getLLVMTypeOfType(funcParam.getType(), module));
+    // (without function body) and adding to Module. A partition only needs
+    // its own functions and their callees, which keeps small partitions
+    // cheap on packages with many functions.
+    if (partition == nullptr) {
+        for (const auto &function : obj.functions) {
+            declareFunction(function);
         }
-
-        bool isVarArg = static_cast<bool>(function.getRestParam());
-        auto *funcType =
-            llvm::FunctionType::get(FunctionCodeGen::getRetValType(function, module), paramTypes, isVarArg);
-
-        llvm::Function::Create(funcType, llvm::GlobalValue::ExternalLinkage, function.getName(), module);
-    }
-
-    // iterating over each function translate the function body
-    for (auto &function : obj.functions) {
-        if (function.isExternalFunction()) {
-            continue;
+    } else {
+        for (auto functionIndex : partition->functionIndices) {
+            const auto &function = obj.functions[functionIndex];
+            declareFunction(function);
+            for (auto calleeName : function.getCalleeNames()) {
+                auto callee = obj.functionIndices.find(calleeName);
+                if (callee != obj.functionIndices.end()) {
+                    declareFunction(obj.functions[callee->second]);
+                }
+            }
         }
-        FunctionCodeGen funcGenerator(*this);
-        funcGenerator.visit(function, builder);
     }
+}
+
+void PackageCodeGen::lowerFunction(Function &function, llvm::IRBuilder<> &builder) {
+    PhaseScope phase("Lower function", llvm::StringRef(function.getName().data(), function.getName().size()));
+    FunctionCodeGen funcGenerator(*this);
+    funcGenerator.visit(function, builder);
+}
 
+void PackageCodeGen::finalizeModule(llvm::IRBuilder<> &builder) {
     // This Api will finalize the string table builder if table size is not zero
     if (strBuilder->getSize() != 0) {
         applyStringOffsetRelocations(builder);
@@ -87,69 +137,131 @@ void PackageCodeGen::visit(Package &obj, llvm::IRBuilder<> &builder) {
         // like below example.
         // char arr[100] = { 'a' };
         // char *ptr = arr;
-        auto *bitCastRes = builder.CreateBitCast(globalStrTable2, charPtrType, "");
+        auto *bitCastRes = builder.CreateBitCast(globalStrTable2, builder.getInt8PtrTy(), "");
         globalStrTable->setInitializer(llvm::dyn_cast<llvm::Constant>(bitCastRes));
     }
 
+    PhaseScope phase("Verify module");
     assert(!llvm::verifyModule(module, &llvm::outs()));
 }
 
-llvm::Value *PackageCodeGen::addToStringTable(std::string_view newString, llvm::IRBuilder<> &builder) {
-    if (!strBuilder->contains(newString.data())) {
-        strBuilder->add(newString.data());
+void PackageCodeGen::declareFunction(const Function &function) {
+    if (module.getFunction(llvm::StringRef(function.getName())) != nullptr) {
+        return;
+    }
+    // Declared from the function table signature, as the body may not be
+    // decoded yet when functions are streamed in
+    const auto &signature = function.getSignature();
+    assert(signature.has_value());
+    std::vector<llvm::Type *> paramTypes;
+    paramTypes.reserve(signature->getParamTypes().size());
+    for (const auto *paramType : signature->getParamTypes()) {
+        paramTypes.push_back(getLLVMType(*paramType));
+    }
+    auto *returnType = function.isMainFunction() ? llvm::Type::getVoidTy(module.getContext())
+                                                 : getLLVMType(signature->getReturnType());
+
+    bool isVarArg = static_cast<bool>(function.getRestParam());
+    auto *funcType = llvm::FunctionType::get(returnType, paramTypes, isVarArg);
+
+    llvm::Function::Create(funcType, llvm::GlobalValue::ExternalLinkage, llvm::StringRef(function.getName()), module);
+}
+
+// Longest processing time first: the largest remaining function goes to the
+// partition with the fewest instructions so far
+std::vector<ModulePartition> PackageCodeGen::partition(const Package &obj, unsigned count) {
+    std::vector<uint32_t> functionIndices;
+    std::vector<size_t> instructionCounts(obj.functions.size(), 0);
+    for (uint32_t i = 0; i < obj.functions.size(); i++) {
+        if (!obj.functions[i].isExternalFunction()) {
+            functionIndices.push_back(i);
+            instructionCounts[i] = obj.functions[i].getInstructionCount();
+        }
+    }
+    std::stable_sort(functionIndices.begin(), functionIndices.end(),
+                     [&](uint32_t lhs, uint32_t rhs) { return instructionCounts[lhs] > instructionCounts[rhs]; });
+
+    count = std::max<size_t>(1, std::min<size_t>(count, functionIndices.size()));
+    std::vector<ModulePartition> partitions(count);
+    using PartitionLoad = std::pair<size_t, unsigned>;
+    std::priority_queue<PartitionLoad, std::vector<PartitionLoad>, std::greater<PartitionLoad>> loads;
+    for (unsigned i = 0; i < count; i++) {
+        loads.emplace(0, i);
+    }
+    for (auto functionIndex : functionIndices) {
+        auto [load, partitionIndex] = loads.top();
+        loads.pop();
+        partitions[partitionIndex].functionIndices.push_back(functionIndex);
+        loads.emplace(load + instructionCounts[functionIndex], partitionIndex);
     }
-    int tempRandNum1 = std::rand() % 1000 + 1;
-    auto *constValue = builder.getInt64(tempRandNum1);
+    // Keep the package order within each module
+    for (auto &modulePartition : partitions) {
+        std::sort(modulePartition.functionIndices.begin(), modulePartition.functionIndices.end());
+    }
+    partitions.front().definesGlobals = true;
+    return partitions;
+}
+
+llvm::Type *PackageCodeGen::getLLVMType(const Type &type) {
+    auto typeIndex = type.getIndex();
+    // With --pipeline, types are still being interned for the function
+    // bodies decoded after the package was declared
+    if (typeIndex >= llvmTypes.size()) {
+        llvmTypes.resize(typeIndex + 1, nullptr);
+    }
+    if (llvmTypes[typeIndex] == nullptr) {
+        llvmTypes[typeIndex] = CodeGenUtils::getLLVMTypeOfType(type, module);
+    }
+    return llvmTypes[typeIndex];
+}
+
+llvm::GlobalVariable *PackageCodeGen::getGlobalVariable(uint32_t index) const {
+    if (index >= globalVarRefs.size()) {
+        return nullptr;
+    }
+    return globalVarRefs[index];
+}
+
+llvm::FunctionCallee PackageCodeGen::getRuntimeFunction(RuntimeFunction function, TypeTag memberTypeTag) {
+    auto &callee = runtimeFunctions[{function, memberTypeTag}];
+    if (!callee) {
+        callee = CodeGenUtils::getRuntimeFunction(module, function, memberTypeTag);
+    }
+    return callee;
+}
+
+// The offset is a placeholder until the table is finalized, see
+// applyStringOffsetRelocations
+llvm::Value *PackageCodeGen::addToStringTable(std::string_view newString, llvm::IRBuilder<> &builder) {
+    llvm::StringRef value(newString.data(), newString.size());
+    strBuilder->add(value);
     auto *strTblLoad = builder.CreateLoad(globalStrTable);
-    auto *strTablePosition = builder.CreateInBoundsGEP(strTblLoad, llvm::ArrayRef<llvm::Value *>({constValue}));
-    structElementStoreInst[newString.data()].push_back(strTablePosition);
+    auto *strTablePosition = llvm::cast<llvm::GetElementPtrInst>(
+        builder.CreateInBoundsGEP(strTblLoad, llvm::ArrayRef<llvm::Value *>({builder.getInt64(0)})));
+    stringOffsetFixups.emplace_back(value, strTablePosition);
     return strTablePosition;
 }
 
-// Finalizing the string table after storing all the values into string table
-// and Storing the any type data (string table offset).
+// Finalizes the string table, points every lookup at the final offset of its
+// string and creates the table global. The layout only depends on the strings
+// added, so the same package always produces the same module.
 void PackageCodeGen::applyStringOffsetRelocations(llvm::IRBuilder<> &builder) {
-
-    // finalizing the string builder table.
     strBuilder->finalize();
-    // After finalize the string table, re arranging the actual offset values.
-    std::vector<std::pair<size_t, std::string>> offsetStringPair;
-    offsetStringPair.reserve(structElementStoreInst.size());
-
-    for (const auto &element : structElementStoreInst) {
-        const std::string &typeString = element.first;
-        size_t finalOrigOffset = strBuilder->getOffset(element.first);
-        offsetStringPair.emplace_back(finalOrigOffset, typeString);
+    for (const auto &[value, strTablePosition] : stringOffsetFixups) {
+        strTablePosition->setOperand(1, builder.getInt64(strBuilder->getOffset(value)));
     }
 
-    // creating the concat string to store in the global address space(string table
-    // global pointer)
+    // Suffixes may share the bytes of a longer string, so the table is
+    // written out by the builder rather than concatenated here
     std::string concatString;
-    std::sort(offsetStringPair.begin(), offsetStringPair.end());
-    for (const auto &pair : offsetStringPair) {
-        concatString.append(pair.second);
-    }
-
-    for (const auto &element : structElementStoreInst) {
-        size_t finalOrigOffset = strBuilder->getOffset(element.first);
-        auto *tempVal = builder.getInt64(finalOrigOffset);
-        for (const auto &insn : element.second) {
-            auto *GEPInst = llvm::dyn_cast<llvm::GetElementPtrInst>(insn);
-            if (GEPInst != nullptr) {
-                GEPInst->getOperand(1)->replaceAllUsesWith(tempVal);
-                continue;
-            }
-            auto *temp = llvm::dyn_cast<llvm::User>(insn);
-            if (temp != nullptr) {
-                temp->getOperand(0)->replaceAllUsesWith(tempVal);
-            } else {
-                llvm_unreachable("");
-            }
-        }
-    }
+    llvm::raw_string_ostream concatStream(concatString);
+    strBuilder->write(concatStream);
+    concatStream.flush();
 
     auto *arrayType = llvm::ArrayType::get(llvm::Type::getInt8Ty(module.getContext()), concatString.size() + 1);
-    globalStrTable2 = new llvm::GlobalVariable(module, arrayType, false, llvm::GlobalValue::ExternalLinkage, nullptr,
+    // Offsets are only known within this module, so every module (or
+    // partition of a package) has a table of its own
+    globalStrTable2 = new llvm::GlobalVariable(module, arrayType, false, llvm::GlobalValue::InternalLinkage, nullptr,
                                                STRING_TABLE_NAME, nullptr, llvm::GlobalVariable::NotThreadLocal, 0);
     auto *constString = llvm::ConstantDataArray::getString(module.getContext(), concatString);
     // Initializing global address space with generated string(concat all the
@@ -34,7 +34,7 @@ void NonTerminatorInsnCodeGen::mapCreateTranslate(StructureInsn &obj, const Vari
     const auto &mapType = lhsVar.getType();
     TypeTag memberTypeTag = mapType.getMemberTypeTag();
     Type::checkMapSupport(memberTypeTag);
-    auto newMapIntFunc = CodeGenUtils::getNewMapInitFunc(moduleGenerator.getModule());
+    auto newMapIntFunc = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_MAP_CREATE);
     auto *newMapIntRef = builder.CreateCall(newMapIntFunc);
     builder.CreateStore(newMapIntRef, lhsOpRef);
 }
@@ -43,8 +43,8 @@ void NonTerminatorInsnCodeGen::mapInitTranslate(StructureInsn &obj, const Variab
                                                 llvm::IRBuilder<> &builder) {
     TypeTag memTypeTag = lhsVar.getType().getMemberTypeTag();
     Type::checkMapSupport(memTypeTag);
-    auto mapStoreFunc = CodeGenUtils::getMapStoreFunc(moduleGenerator.getModule());
-    auto mapSpreadFieldFunc = CodeGenUtils::getMapSpreadFieldInitFunc(moduleGenerator.getModule());
+    auto mapStoreFunc = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_MAP_STORE);
+    auto mapSpreadFieldFunc = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_MAP_SPREAD_FIELD_INIT);
     for (const auto &initValue : obj.initValues) {
         const auto &initstruct = initValue.getInitValStruct();
         if (initValue.getKind() == Spread_Field_Kind) {
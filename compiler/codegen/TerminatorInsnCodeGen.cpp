@@ -29,13 +29,32 @@ namespace nballerina {
 TerminatorInsnCodeGen::TerminatorInsnCodeGen(FunctionCodeGen &functionGenerator, PackageCodeGen &moduleGenerator)
     : functionGenerator(functionGenerator), moduleGenerator(moduleGenerator) {}
 
+void TerminatorInsnCodeGen::visit(TerminatorInsn &obj, llvm::IRBuilder<> &builder) {
+    switch (obj.getKind()) {
+    case INSTRUCTION_KIND_CONDITIONAL_BRANCH:
+        visit(static_cast<ConditionBrInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_CALL:
+        visit(static_cast<FunctionCallInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_GOTO:
+        visit(static_cast<GoToInsn &>(obj), builder);
+        break;
+    case INSTRUCTION_KIND_RETURN:
+        visit(static_cast<ReturnInsn &>(obj), builder);
+        break;
+    default:
+        llvm_unreachable("Unsupported terminator instruction");
+    }
+}
+
 void TerminatorInsnCodeGen::visit(ConditionBrInsn &obj, llvm::IRBuilder<> &builder) {
     auto *lhsTemp = functionGenerator.createTempVal(obj.lhsOp, builder);
-    auto *brCondition = builder.CreateIsNotNull(lhsTemp, obj.lhsOp.getName());
-    assert(functionGenerator.getBasicBlock(obj.thenBBID) != nullptr);
-    assert(functionGenerator.getBasicBlock(obj.getElseBBID()) != nullptr);
-    builder.CreateCondBr(brCondition, functionGenerator.getBasicBlock(obj.thenBBID),
-                         functionGenerator.getBasicBlock(obj.getElseBBID()));
+    auto *brCondition = builder.CreateIsNotNull(lhsTemp, llvm::StringRef(obj.lhsOp.getName()));
+    assert(functionGenerator.getBasicBlock(obj.thenBBIndex) != nullptr);
+    assert(functionGenerator.getBasicBlock(obj.getElseBBIndex()) != nullptr);
+    builder.CreateCondBr(brCondition, functionGenerator.getBasicBlock(obj.thenBBIndex),
+                         functionGenerator.getBasicBlock(obj.getElseBBIndex()));
 }
 
 void TerminatorInsnCodeGen::visit(FunctionCallInsn &obj, llvm::IRBuilder<> &builder) {
@@ -51,15 +70,15 @@ void TerminatorInsnCodeGen::visit(FunctionCallInsn &obj, llvm::IRBuilder<> &buil
     builder.CreateStore(callResult, lhsRef);
 
     // creating branch to next basic block.
-    auto *nextBB = functionGenerator.getBasicBlock(obj.thenBBID);
+    auto *nextBB = functionGenerator.getBasicBlock(obj.thenBBIndex);
     if (nextBB != nullptr) {
         builder.CreateBr(nextBB);
     }
 }
 
 void TerminatorInsnCodeGen::visit(GoToInsn &obj, llvm::IRBuilder<> &builder) {
-    assert(functionGenerator.getBasicBlock(obj.thenBBID) != nullptr);
-    builder.CreateBr(functionGenerator.getBasicBlock(obj.thenBBID));
+    assert(functionGenerator.getBasicBlock(obj.thenBBIndex) != nullptr);
+    builder.CreateBr(functionGenerator.getBasicBlock(obj.thenBBIndex));
 }
 
 void TerminatorInsnCodeGen::visit(ReturnInsn &obj, llvm::IRBuilder<> &builder) {
@@ -69,8 +88,8 @@ void TerminatorInsnCodeGen::visit(ReturnInsn &obj, llvm::IRBuilder<> &builder) {
         return;
     }
     assert(funcObj.getReturnVar().has_value());
-    auto *retValueRef =
-        builder.CreateLoad(functionGenerator.getLocalVal(funcObj.getReturnVar()->getName()), "return_val_temp");
+    auto returnVarIndex = funcObj.getLocalVarIndex(funcObj.getReturnVar()->getName());
+    auto *retValueRef = builder.CreateLoad(functionGenerator.getLocalVal(returnVarIndex), "return_val_temp");
     builder.CreateRet(retValueRef);
 }
 } // namespace nballerina
@@ -49,7 +49,7 @@ void NonTerminatorInsnCodeGen::visit(class TypeCastInsn &obj, llvm::IRBuilder<>
         if (lhsTypeTag == TYPE_TAG_INT) {
             // call the any_to_int function to typecast from any to int type.
             auto *rhsValueRef = llvm::dyn_cast<llvm::Instruction>(builder.CreateLoad(rhsOpRef, ""));
-            auto *namedFuncRef = CodeGenUtils::getAnyToIntFunction(module);
+            auto namedFuncRef = moduleGenerator.getRuntimeFunction(RUNTIME_FUNCTION_ANY_TO_INT);
             auto *callResult = builder.CreateCall(namedFuncRef, llvm::ArrayRef<llvm::Value *>({rhsValueRef}));
             builder.CreateStore(callResult, lhsOpRef);
         } else {
@@ -30,12 +30,12 @@ void NonTerminatorInsnCodeGen::visit(class UnaryOpInsn &obj, llvm::IRBuilder<> &
 
     switch (obj.kind) {
     case INSTRUCTION_KIND_UNARY_NOT: {
-        auto *ifReturn = builder.CreateNot(rhsOpref, obj.lhsOp.getName() + "_temp");
+        auto *ifReturn = builder.CreateNot(rhsOpref, llvm::StringRef(obj.lhsOp.getName()) + "_temp");
         builder.CreateStore(ifReturn, lhsRef);
         break;
     }
     case INSTRUCTION_KIND_UNARY_NEG: {
-        auto *ifReturn = builder.CreateNeg(rhsOpref, obj.lhsOp.getName() + "_temp");
+        auto *ifReturn = builder.CreateNeg(rhsOpref, llvm::StringRef(obj.lhsOp.getName()) + "_temp");
         builder.CreateStore(ifReturn, lhsRef);
         break;
     }
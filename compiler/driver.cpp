@@ -16,11 +16,59 @@
  * under the License.
  */
 
+#include "bir/CompilerStats.h"
 #include "bir/Package.h"
 #include "codegen/CodeGenerator.h"
+#include "codegen/JITRunner.h"
 #include "reader/BIRFileReader.h"
+#include "server/CompileServer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/StringSaver.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Support/raw_ostream.h>
 #include <string>
+#include <thread>
+#include <vector>
+
+struct DriverOptions {
+    std::vector<std::string> inFileNames;
+    std::string outFileName;
+    nballerina::ReaderOptions readerOptions;
+    nballerina::CodeGenOptions codeGenOptions;
+    bool benchReader = false;
+    bool benchCodegen = false;
+    bool run = false;
+    // Decode function bodies on a reader thread while codegen lowers them
+    bool pipeline = false;
+    bool stats = false;
+    // Unix domain socket to serve compile requests on, or to send them to
+    std::string serverSocket;
+    std::string connectSocket;
+    bool timeTrace = false;
+    std::string timeTraceFileName;
+    // Spans shorter than this (in microseconds) are left out of the trace
+    unsigned timeTraceGranularity = 500;
+    // Set when an option could not be parsed, the error is already printed
+    bool invalid = false;
+};
+
+// Outcome of compiling one input in batch mode
+struct CompileResult {
+    bool succeeded = false;
+    std::string message;
+    double seconds = 0;
+    size_t irBytes = 0;
+};
 
 std::string removeExtension(const std::string &path) {
     size_t pos = path.find_last_of("\\/.");
@@ -30,36 +78,397 @@ std::string removeExtension(const std::string &path) {
     return path;
 }
 
-int main(int argc, char **argv) {
-    std::string inFileName;
-    std::string outFileName;
-    std::string exeName;
-    if (argc <= 1) {
-        std::cerr << "Need input file name" << std::endl;
-        exit(0);
+std::string defaultOutFileName(const std::string &inFileName, nballerina::OutputKind outputKind) {
+    // BIR read from stdin is written to stdout.
+    if (inFileName == "-") {
+        return "-";
     }
+    return removeExtension(inFileName) + nballerina::getOutputExtension(outputKind);
+}
 
-    int i = 0;
-    while (i < argc) {
-        std::string arg = std::string(argv[i]);
+// Parses the numeric value of option, or prints an error and leaves result as is
+bool parseUnsigned(llvm::StringRef option, llvm::StringRef value, unsigned &result) {
+    if (value.getAsInteger(10, result)) {
+        std::cerr << "Invalid value for " << option.str() << ": '" << value.str() << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+DriverOptions parseOptions(llvm::ArrayRef<const char *> args) {
+    DriverOptions options;
+    size_t i = 1;
+    while (i < args.size()) {
+        std::string arg = std::string(args[i]);
         if (arg == "-c") {
             i++;
-        } else if (arg == "-o") {
-            outFileName = std::string(argv[i + 1]);
+        } else if (arg == "-o" && i + 1 < args.size()) {
+            options.outFileName = std::string(args[i + 1]);
             i += 2;
+        } else if (arg == "--reader=stream") {
+            options.readerOptions.mode = nballerina::READER_MODE_STREAM;
+            i++;
+        } else if (arg == "--reader=mmap") {
+            options.readerOptions.mode = nballerina::READER_MODE_MMAP;
+            i++;
+        } else if (arg == "-j" && i + 1 < args.size()) {
+            options.invalid |= !parseUnsigned("-j", args[i + 1], options.readerOptions.jobs);
+            i += 2;
+        } else if (arg.rfind("--jobs=", 0) == 0) {
+            options.invalid |=
+                !parseUnsigned("--jobs", arg.substr(std::string("--jobs=").size()), options.readerOptions.jobs);
+            i++;
+        } else if (arg.rfind("--ignore-function=", 0) == 0) {
+            options.readerOptions.ignoredFunctions.addPrefix(arg.substr(std::string("--ignore-function=").size()));
+            i++;
+        } else if (arg == "--reachable-only") {
+            options.readerOptions.reachableOnly = true;
+            i++;
+        } else if (arg.rfind("--entry=", 0) == 0) {
+            options.readerOptions.entryPoints.push_back(arg.substr(std::string("--entry=").size()));
+            i++;
+        } else if (arg.size() == 3 && arg.rfind("-O", 0) == 0 && arg[2] >= '0' && arg[2] <= '3') {
+            options.codeGenOptions.optLevel = arg[2] - '0';
+            i++;
+        } else if (arg == "--emit=llvm") {
+            options.codeGenOptions.outputKind = nballerina::OUTPUT_KIND_LLVM_IR;
+            i++;
+        } else if (arg == "--emit=obj") {
+            options.codeGenOptions.outputKind = nballerina::OUTPUT_KIND_OBJECT;
+            i++;
+        } else if (arg == "--emit=asm") {
+            options.codeGenOptions.outputKind = nballerina::OUTPUT_KIND_ASSEMBLY;
+            i++;
+        } else if (arg == "--emit=bc") {
+            options.codeGenOptions.outputKind = nballerina::OUTPUT_KIND_BITCODE;
+            i++;
+        } else if (arg == "--split-codegen") {
+            options.codeGenOptions.partitions = llvm::hardware_concurrency().compute_thread_count();
+            i++;
+        } else if (arg.rfind("--split-codegen=", 0) == 0) {
+            options.invalid |= !parseUnsigned("--split-codegen", arg.substr(std::string("--split-codegen=").size()),
+                                              options.codeGenOptions.partitions);
+            i++;
+        } else if (arg.rfind("--cache-dir=", 0) == 0) {
+            options.codeGenOptions.cacheDirectory = arg.substr(std::string("--cache-dir=").size());
+            i++;
+        } else if (arg.rfind("--bir-cache=", 0) == 0) {
+            options.readerOptions.cacheDirectory = arg.substr(std::string("--bir-cache=").size());
+            i++;
+        } else if (arg == "--run") {
+            options.run = true;
+            i++;
+        } else if (arg.rfind("--runtime-lib=", 0) == 0) {
+            options.codeGenOptions.runtimeLibraries.push_back(arg.substr(std::string("--runtime-lib=").size()));
+            i++;
+        } else if (arg == "--perf-map") {
+            options.codeGenOptions.perfMap = true;
+            i++;
+        } else if (arg == "--pipeline") {
+            options.pipeline = true;
+            i++;
+        } else if (arg.rfind("--server=", 0) == 0) {
+            options.serverSocket = arg.substr(std::string("--server=").size());
+            i++;
+        } else if (arg.rfind("--connect=", 0) == 0) {
+            options.connectSocket = arg.substr(std::string("--connect=").size());
+            i++;
+        } else if (arg == "--stats") {
+            options.stats = true;
+            i++;
+        } else if (arg == "--time-trace") {
+            options.timeTrace = true;
+            i++;
+        } else if (arg.rfind("--time-trace=", 0) == 0) {
+            options.timeTrace = true;
+            options.timeTraceFileName = arg.substr(std::string("--time-trace=").size());
+            i++;
+        } else if (arg.rfind("--time-trace-granularity=", 0) == 0) {
+            options.invalid |= !parseUnsigned("--time-trace-granularity",
+                                              arg.substr(std::string("--time-trace-granularity=").size()),
+                                              options.timeTraceGranularity);
+            i++;
+        } else if (arg == "--bench-reader") {
+            options.benchReader = true;
+            i++;
+        } else if (arg == "--bench-codegen") {
+            options.benchCodegen = true;
+            i++;
         } else {
-            inFileName = std::string(argv[i]);
+            options.inFileNames.push_back(arg);
             i++;
         }
     }
+    return options;
+}
+
+// Compare the stream and mmap readers on this input
+void benchReader(const std::string &inFileName, const nballerina::ReaderOptions &readerOptions) {
+    const unsigned iterations = 5;
+    auto streamOptions = readerOptions;
+    streamOptions.mode = nballerina::READER_MODE_STREAM;
+    auto mmapOptions = readerOptions;
+    mmapOptions.mode = nballerina::READER_MODE_MMAP;
+    std::cout << "BIR reader throughput (" << iterations << " iterations):" << std::endl;
+    auto streamRate = nballerina::BIRFileReader::measureThroughput(inFileName, streamOptions, iterations);
+    auto mmapRate = nballerina::BIRFileReader::measureThroughput(inFileName, mmapOptions, iterations);
+    std::cout << "  stream : " << streamRate << " MB/s" << std::endl;
+    std::cout << "  mmap   : " << mmapRate << " MB/s" << std::endl;
+}
+
+// Time the translation of an already decoded package to LLVM IR
+void benchCodegen(nballerina::Package &birPackage) {
+    const unsigned iterations = 5;
+    auto [msPerModule, instructionsPerSecond] =
+        nballerina::CodeGenerator::measureThroughput(birPackage, iterations);
+    std::cout << "Codegen throughput (" << iterations << " iterations):" << std::endl;
+    std::cout << "  " << msPerModule << " ms per module, " << instructionsPerSecond << " instructions/s"
+              << std::endl;
+}
+
+// The runtime archives as laid out in the build directory, next to nballerinacc
+std::vector<std::string> defaultRuntimeLibraries(const char *argv0) {
+    std::string executable = llvm::sys::fs::getMainExecutable(argv0, (void *)&defaultRuntimeLibraries);
+    llvm::SmallString<256> buildDir(llvm::sys::path::parent_path(executable));
+    std::vector<std::string> runtimeLibraries;
+    for (auto *archive : {"runtime/rust_rt/release/libballerina_rt.a", "runtime/c_rt/libballerina_crt.a"}) {
+        llvm::SmallString<256> archivePath(buildDir);
+        llvm::sys::path::append(archivePath, archive);
+        if (llvm::sys::fs::exists(archivePath)) {
+            runtimeLibraries.push_back(std::string(archivePath));
+        }
+    }
+    return runtimeLibraries;
+}
+
+CompileResult compileFile(const std::string &inFileName, const nballerina::ReaderOptions &readerOptions,
+                          const nballerina::CodeGenOptions &codeGenOptions, llvm::LLVMContext &context) {
+    CompileResult result;
+    auto start = std::chrono::steady_clock::now();
+    if (!llvm::sys::fs::exists(inFileName)) {
+        result.message = "no such file";
+        return result;
+    }
+    auto outFileName = defaultOutFileName(inFileName, codeGenOptions.outputKind);
+    auto birPackage = nballerina::BIRFileReader::deserialize(inFileName, readerOptions);
+    result.irBytes = birPackage->getArenaBytes();
+    result.succeeded =
+        nballerina::CodeGenerator::generateLLVMIR(*birPackage, outFileName, context, codeGenOptions) == 0;
+    result.message = result.succeeded ? outFileName : "unable to write " + outFileName;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.seconds = elapsed.count();
+    return result;
+}
+
+// Compiles every input on its own worker pool. Each worker owns one
+// LLVMContext and pulls the next input when it is done with the last, so a
+// few large packages do not hold up the rest.
+int compileBatch(const DriverOptions &options) {
+    auto &inFileNames = options.inFileNames;
+    auto readerOptions = options.readerOptions;
+    unsigned workerCount = llvm::hardware_concurrency(readerOptions.jobs).compute_thread_count();
+    workerCount = std::max(1u, std::min<unsigned>(workerCount, inFileNames.size()));
+    // Packages already run in parallel, so decode each one on its worker
+    readerOptions.jobs = 1;
+
+    std::vector<CompileResult> results(inFileNames.size());
+    std::atomic<size_t> nextInput{0};
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < workerCount; w++) {
+        workers.emplace_back([&]() {
+            nballerina::TraceThreadScope traceThread;
+            llvm::LLVMContext context;
+            for (size_t i = nextInput++; i < inFileNames.size(); i = nextInput++) {
+                results[i] = compileFile(inFileNames[i], readerOptions, options.codeGenOptions, context);
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    size_t failures = 0;
+    for (size_t i = 0; i < inFileNames.size(); i++) {
+        const auto &result = results[i];
+        if (result.succeeded) {
+            std::cout << "  ok    " << inFileNames[i] << " -> " << result.message << " (" << result.seconds * 1000
+                      << " ms, " << result.irBytes / 1024 << " KiB IR)" << std::endl;
+        } else {
+            std::cout << "  FAIL  " << inFileNames[i] << ": " << result.message << std::endl;
+            failures++;
+        }
+    }
+    std::cout << inFileNames.size() - failures << " compiled, " << failures << " failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+// Compiles (or runs) the one input, and prints --stats for it
+int compileSingle(DriverOptions &options, const char *argv0) {
+    auto &inFileName = options.inFileNames.front();
     // if output file name is empty from command line options.
-    if (outFileName.empty()) {
-        outFileName = removeExtension(inFileName);
-        outFileName = outFileName + ".ll";
+    if (options.outFileName.empty()) {
+        if (!options.codeGenOptions.cacheDirectory.empty() && inFileName != "-") {
+            options.outFileName = removeExtension(inFileName) + ".rsp";
+        } else {
+            options.outFileName = defaultOutFileName(inFileName, options.codeGenOptions.outputKind);
+        }
+    }
+    if (options.benchReader) {
+        benchReader(inFileName, options.readerOptions);
+    }
+
+    if (options.pipeline) {
+        auto stream = nballerina::BIRFileReader::openFunctionStream(inFileName, options.readerOptions);
+        int result = nballerina::CodeGenerator::generateStreamed(
+            stream->getPackage(), [&stream]() { return stream->readNextFunction(); }, options.outFileName,
+            options.codeGenOptions);
+        // The function bodies are gone by now, only the phases and peak RSS are left to report
+        if (options.stats) {
+            nballerina::CompilerStats::print(llvm::errs(), stream->getPackage(), true);
+        }
+        return result;
+    }
+
+    auto birPackage = nballerina::BIRFileReader::deserialize(inFileName, options.readerOptions);
+    // Only regular files go through the package cache
+    if (!options.readerOptions.cacheDirectory.empty() && llvm::sys::fs::is_regular_file(inFileName)) {
+        llvm::errs() << "BIR cache: " << (birPackage->isFromPackageCache() ? "hit" : "miss") << "\n";
+    }
+    if (options.benchCodegen) {
+        benchCodegen(*birPackage);
+    }
+
+    int result = 0;
+    if (options.run) {
+        if (options.codeGenOptions.runtimeLibraries.empty()) {
+            options.codeGenOptions.runtimeLibraries = defaultRuntimeLibraries(argv0);
+        }
+        result = nballerina::JITRunner::run(*birPackage, options.codeGenOptions);
+    } else if (!options.codeGenOptions.cacheDirectory.empty()) {
+        nballerina::CacheStats stats;
+        result = nballerina::CodeGenerator::generateCached(*birPackage, options.outFileName, options.codeGenOptions,
+                                                           stats);
+        // To stderr, as the response file goes to stdout for stdin input
+        llvm::errs() << "Function cache: " << stats.hits << " hits, " << stats.misses << " misses\n";
+    } else {
+        // Codegen
+        result = nballerina::CodeGenerator::generateLLVMIR(*birPackage, options.outFileName, options.codeGenOptions);
+    }
+
+    // Stats go to stderr, the module may have been written to stdout
+    if (options.stats) {
+        nballerina::CompilerStats::print(llvm::errs(), *birPackage);
+    }
+    return result;
+}
+
+// Writes the spans of all threads as Chrome trace JSON
+void writeTimeTrace(const std::string &fileName) {
+    std::error_code EC;
+    llvm::raw_fd_ostream traceStream(fileName, EC, llvm::sys::fs::OF_Text);
+    if (EC) {
+        std::cerr << "Unable to write " << fileName << ": " << EC.message() << std::endl;
+    } else {
+        llvm::timeTraceProfilerWrite(traceStream);
+    }
+    llvm::timeTraceProfilerCleanup();
+}
+
+// Compiles the inputs of an already parsed command line
+int compile(DriverOptions &options, const char *argv0) {
+    if (options.invalid) {
+        return 1;
+    }
+    if (options.inFileNames.empty()) {
+        std::cerr << "Need input file name" << std::endl;
+        return 1;
+    }
+
+    bool isBatch = options.inFileNames.size() > 1;
+    if (isBatch && (!options.outFileName.empty() || options.benchReader || options.benchCodegen || options.run ||
+                    options.stats || options.pipeline || options.codeGenOptions.partitions > 1 ||
+                    !options.codeGenOptions.cacheDirectory.empty())) {
+        std::cerr << "-o, --run, --split-codegen, --cache-dir, --pipeline, --stats, --bench-reader and "
+                     "--bench-codegen take a single input file"
+                  << std::endl;
+        return 1;
+    }
+    if (options.pipeline && (options.run || options.benchCodegen || options.readerOptions.reachableOnly ||
+                             options.codeGenOptions.partitions > 1 || !options.codeGenOptions.cacheDirectory.empty() ||
+                             !options.readerOptions.cacheDirectory.empty())) {
+        std::cerr << "--pipeline can not be combined with --run, --split-codegen, --cache-dir, --bir-cache, "
+                     "--reachable-only or --bench-codegen"
+                  << std::endl;
+        return 1;
+    }
+
+    if (options.stats) {
+        nballerina::CompilerStats::enableStats();
+    }
+    if (options.timeTrace) {
+        if (options.timeTraceFileName.empty()) {
+            const auto &inFileName = options.inFileNames.front();
+            options.timeTraceFileName =
+                (isBatch || inFileName == "-" ? "nballerinacc" : removeExtension(inFileName)) + ".time-trace.json";
+        }
+        nballerina::CompilerStats::enableTimeTrace(options.timeTraceGranularity);
     }
 
-    auto birPackage = nballerina::BIRFileReader::deserialize(inFileName);
+    int result = isBatch ? compileBatch(options) : compileSingle(options, argv0);
+    if (options.timeTrace) {
+        writeTimeTrace(options.timeTraceFileName);
+    }
+    return result;
+}
 
-    // Codegen
-    return nballerina::CodeGenerator::generateLLVMIR(*birPackage, outFileName);
+// Serves compile requests until killed. The target is initialized here once,
+// and every request starts from a fork of this process.
+int serve(const DriverOptions &options, const char *argv0) {
+    if (!options.inFileNames.empty() || !options.connectSocket.empty()) {
+        std::cerr << "--server takes no input files, they are sent by the clients" << std::endl;
+        return 1;
+    }
+    nballerina::CodeGenerator::initializeNativeTarget();
+    return nballerina::CompileServer::serve(options.serverSocket, [argv0](llvm::ArrayRef<const char *> args) {
+        auto requestOptions = parseOptions(args);
+        return compile(requestOptions, argv0);
+    });
+}
+
+int main(int argc, char **argv) {
+    if (argc <= 1) {
+        std::cerr << "Need input file name" << std::endl;
+        exit(0);
+    }
+
+    // Expand @file response files in place
+    llvm::BumpPtrAllocator argStorage;
+    llvm::StringSaver argSaver(argStorage);
+    llvm::SmallVector<const char *, 64> args(argv, argv + argc);
+    if (!llvm::cl::ExpandResponseFiles(argSaver, llvm::cl::TokenizeGNUCommandLine, args)) {
+        std::cerr << "Unable to read response file" << std::endl;
+        return 1;
+    }
+    auto options = parseOptions(args);
+    if (options.invalid) {
+        return 1;
+    }
+    if (!options.serverSocket.empty()) {
+        return serve(options, argv[0]);
+    }
+
+    // Hand the compile to a running server, or do it here when there is none.
+    // stdin can not be forwarded.
+    const auto &inFileNames = options.inFileNames;
+    bool readsStdin = std::find(inFileNames.begin(), inFileNames.end(), "-") != inFileNames.end();
+    if (!options.connectSocket.empty() && !readsStdin) {
+        std::vector<const char *> forwardedArgs;
+        std::copy_if(args.begin(), args.end(), std::back_inserter(forwardedArgs),
+                     [](const char *arg) { return std::string(arg).rfind("--connect=", 0) != 0; });
+        int result = nballerina::CompileServer::forward(options.connectSocket, forwardedArgs);
+        if (result >= 0) {
+            return result;
+        }
+    }
+    return compile(options, argv[0]);
 }
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __ARENA__H__
+#define __ARENA__H__
+
+#include <llvm/Support/Allocator.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nballerina {
+
+// Bump allocator that owns IR objects (basic blocks, instructions). Objects
+// are never freed one by one: their destructors run in reverse order of
+// creation and the slabs are released together when the arena goes away.
+class Arena {
+  private:
+    llvm::BumpPtrAllocator allocator;
+    std::vector<std::pair<void *, void (*)(void *)>> destructors;
+    void destroyAll();
+
+  public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena(Arena &&other) noexcept;
+    Arena &operator=(const Arena &) = delete;
+    Arena &operator=(Arena &&other) noexcept;
+    ~Arena();
+
+    template <typename T, typename... Args>
+    T *create(Args &&...args) {
+        T *object = new (allocator.Allocate<T>()) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.emplace_back(object, [](void *ptr) { static_cast<T *>(ptr)->~T(); });
+        }
+        return object;
+    }
+
+    // Bytes handed out to objects, excluding slab slack
+    size_t getBytesAllocated() const;
+};
+
+} // namespace nballerina
+
+#endif //!__ARENA__H__
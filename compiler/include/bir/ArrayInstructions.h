@@ -24,36 +24,44 @@
 
 namespace nballerina {
 
-class ArrayInsn : public NonTerminatorInsn, public Translatable<ArrayInsn> {
+class ArrayInsn : public NonTerminatorInsn {
   private:
     Operand sizeOp;
 
   public:
     ArrayInsn(Operand lhs, BasicBlock &currentBB, Operand sizeOp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), sizeOp(std::move(sizeOp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_NEW_ARRAY), sizeOp(std::move(sizeOp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
-class ArrayLoadInsn : public NonTerminatorInsn, public Translatable<ArrayLoadInsn> {
+class ArrayLoadInsn : public NonTerminatorInsn {
   private:
     Operand keyOp;
     Operand rhsOp;
 
   public:
     ArrayLoadInsn(Operand lhs, BasicBlock &currentBB, Operand KOp, Operand ROp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), keyOp(std::move(KOp)), rhsOp(std::move(ROp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_ARRAY_LOAD), keyOp(std::move(KOp)),
+          rhsOp(std::move(ROp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
-class ArrayStoreInsn : public NonTerminatorInsn, public Translatable<ArrayStoreInsn> {
+class ArrayStoreInsn : public NonTerminatorInsn {
   private:
     Operand keyOp;
     Operand rhsOp;
 
   public:
     ArrayStoreInsn(Operand lhs, BasicBlock &currentBB, Operand KOp, Operand ROp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), keyOp(std::move(KOp)), rhsOp(std::move(ROp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_ARRAY_STORE), keyOp(std::move(KOp)),
+          rhsOp(std::move(ROp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
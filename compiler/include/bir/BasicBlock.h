@@ -19,11 +19,12 @@
 #ifndef __BASICBLOCK__H__
 #define __BASICBLOCK__H__
 
+#include "bir/Arena.h"
 #include "interfaces/Debuggable.h"
 #include "interfaces/NonTerminatorInsn.h"
 #include "interfaces/TerminatorInsn.h"
-#include <memory>
-#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace nballerina {
@@ -32,26 +33,38 @@ class Function;
 
 class BasicBlock : public Debuggable {
   private:
-    std::string id;
+    std::string_view id;
     Function *parentFunction;
-    std::unique_ptr<TerminatorInsn> terminator;
-    std::vector<std::unique_ptr<NonTerminatorInsn>> instructions;
+    // Instructions are owned by the function arena
+    TerminatorInsn *terminator;
+    std::vector<NonTerminatorInsn *> instructions;
 
   public:
-    BasicBlock(std::string id, Function *parentFunc);
+    BasicBlock(std::string_view id, Function *parentFunc);
     BasicBlock(const BasicBlock &) = delete;
     BasicBlock(BasicBlock &&j) noexcept = default;
     BasicBlock &operator=(const BasicBlock &) = delete;
     BasicBlock &operator=(BasicBlock &&) noexcept = default;
 
-    const std::string &getId() const;
+    std::string_view getId() const;
     TerminatorInsn *getTerminatorInsnPtr() const;
     const Function &getParentFunctionRef() const;
+    Arena &getArena();
+    // Allocates an instruction of this block in the function arena
+    template <typename InsnT, typename... Args>
+    InsnT *createInsn(Args &&...args) {
+        return getArena().create<InsnT>(std::forward<Args>(args)...);
+    }
 
-    void setTerminatorInsn(std::unique_ptr<TerminatorInsn> insn);
-    void addNonTermInsn(std::unique_ptr<NonTerminatorInsn> insn);
+    void setTerminatorInsn(TerminatorInsn *insn);
+    void addNonTermInsn(NonTerminatorInsn *insn);
 
     friend class BasicBlockCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
+    friend class CompilerStats;
+    friend class Function;
+    template <typename ParserT>
     friend class BIRReadBasicBlock;
 };
 
@@ -25,17 +25,17 @@ namespace nballerina {
 
 class Operand;
 
-class BinaryOpInsn : public NonTerminatorInsn, public Translatable<BinaryOpInsn> {
+class BinaryOpInsn : public NonTerminatorInsn {
   private:
     Operand rhsOp1;
     Operand rhsOp2;
-    InstructionKind kind;
 
   public:
     BinaryOpInsn(Operand lhs, class BasicBlock &currentBB, Operand rhsOp1, Operand rhsOp2, InstructionKind kind)
-        : NonTerminatorInsn(std::move(lhs), currentBB), rhsOp1(std::move(rhsOp1)), rhsOp2(std::move(rhsOp2)),
-          kind(kind) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, kind), rhsOp1(std::move(rhsOp1)), rhsOp2(std::move(rhsOp2)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __COMPILERSTATS__H__
+#define __COMPILERSTATS__H__
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Support/raw_ostream.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nballerina {
+
+class Package;
+
+// Phase timings and memory use behind --stats, and the switch that lets
+// worker threads join the --time-trace output. Nothing is recorded unless
+// enabled, and recording is safe from any thread.
+class CompilerStats {
+  private:
+    struct Phase {
+        std::string name;
+        unsigned count = 0;
+        double seconds = 0;
+        // Exact bytes when the phase reports them, see PhaseScope::setAllocatedBytes
+        bool allocationsKnown = false;
+        size_t allocatedBytes = 0;
+        // Otherwise how much the process peak RSS grew while the phase ran,
+        // and the peak already accounted for, so that instances running
+        // concurrently on several threads do not count the same growth twice
+        size_t peakRSSGrowth = 0;
+        size_t accountedPeakRSS = 0;
+    };
+    struct FunctionTime {
+        std::string name;
+        double seconds = 0;
+    };
+    inline static std::atomic<bool> statsEnabled{false};
+    inline static std::atomic<bool> timeTraceEnabled{false};
+    inline static unsigned timeTraceGranularity = 0;
+    inline static std::mutex statsLock;
+    inline static std::vector<Phase> phases;
+    inline static std::vector<FunctionTime> functionTimes;
+    CompilerStats() = default;
+
+  public:
+    static void enableStats();
+    static bool isStatsEnabled();
+    // Starts the profiler on the calling thread, granularity in microseconds
+    static void enableTimeTrace(unsigned granularity);
+    static bool isTimeTraceEnabled();
+    static unsigned getTimeTraceGranularity();
+    // Peak resident set size of the process in bytes, 0 where unknown
+    static size_t getPeakRSS();
+    // Pass the bytes the phase allocated where known, otherwise the peak RSS
+    // growth since startPeakRSS is recorded instead
+    static void recordPhase(llvm::StringRef name, double seconds, size_t startPeakRSS,
+                            std::optional<size_t> allocatedBytes);
+    static void recordFunction(llvm::StringRef name, double seconds);
+    // With bodiesReleased (--pipeline) the function bodies are gone, and the
+    // decoded IR and instruction counts are left out
+    static void print(llvm::raw_ostream &os, const Package &package, bool bodiesReleased = false);
+};
+
+// Times a phase for --stats and adds a span for it to the --time-trace
+// output. With a detail (the function name), the time is also counted
+// towards that function.
+class PhaseScope {
+  private:
+    llvm::TimeTraceScope traceScope;
+    llvm::StringRef name;
+    llvm::StringRef detail;
+    std::chrono::steady_clock::time_point start;
+    size_t startPeakRSS = 0;
+    std::optional<size_t> allocatedBytes;
+
+  public:
+    PhaseScope(llvm::StringRef name, llvm::StringRef detail = "");
+    PhaseScope(const PhaseScope &) = delete;
+    PhaseScope &operator=(const PhaseScope &) = delete;
+    ~PhaseScope();
+
+    // Reports the bytes this phase allocated, e.g. from Package::getAllocatedBytes,
+    // in place of the peak RSS growth
+    void setAllocatedBytes(size_t bytes);
+};
+
+// Attaches a worker thread (or thread pool task) to the --time-trace output
+class TraceThreadScope {
+  private:
+    bool attached = false;
+
+  public:
+    TraceThreadScope();
+    TraceThreadScope(const TraceThreadScope &) = delete;
+    TraceThreadScope &operator=(const TraceThreadScope &) = delete;
+    ~TraceThreadScope();
+};
+
+} // namespace nballerina
+
+#endif //!__COMPILERSTATS__H__
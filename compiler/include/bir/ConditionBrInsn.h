@@ -24,18 +24,22 @@
 
 namespace nballerina {
 
-class ConditionBrInsn : public TerminatorInsn, public Translatable<ConditionBrInsn> {
+class ConditionBrInsn : public TerminatorInsn {
   private:
-    std::string elseBBID;
+    std::string_view elseBBID;
+    uint32_t elseBBIndex;
 
   public:
-    ConditionBrInsn(Operand lhs, BasicBlock &currentBB, std::string ifBBID, std::string elseBBID)
-        : TerminatorInsn(std::move(lhs), currentBB, ifBBID), elseBBID(std::move(elseBBID)) {
-        kind = INSTRUCTION_KIND_CONDITIONAL_BRANCH;
-    }
+    ConditionBrInsn(Operand lhs, BasicBlock &currentBB, std::string_view ifBBID, std::string_view elseBBID)
+        : TerminatorInsn(std::move(lhs), currentBB, ifBBID, INSTRUCTION_KIND_CONDITIONAL_BRANCH), elseBBID(elseBBID),
+          elseBBIndex(INVALID_BB_INDEX) {}
 
-    const std::string &getElseBBID() const { return elseBBID; }
+    std::string_view getElseBBID() const { return elseBBID; }
+    uint32_t getElseBBIndex() const { return elseBBIndex; }
+    void setElseBBIndex(uint32_t index) { elseBBIndex = index; }
     friend class TerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
@@ -21,28 +21,34 @@
 
 #include "bir/Types.h"
 #include "interfaces/NonTerminatorInsn.h"
-#include <string>
+#include <string_view>
 #include <variant>
 
 namespace nballerina {
 
-class ConstantLoadInsn : public NonTerminatorInsn, public Translatable<ConstantLoadInsn> {
+class ConstantLoadInsn : public NonTerminatorInsn {
   private:
     TypeTag typeTag;
-    std::variant<int64_t, double, bool, std::string> value;
+    std::variant<int64_t, double, bool, std::string_view> value;
 
   public:
     ConstantLoadInsn(Operand lhs, BasicBlock &currentBB, int64_t intVal)
-        : NonTerminatorInsn(std::move(lhs), currentBB), typeTag(TYPE_TAG_INT), value(intVal) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_CONST_LOAD), typeTag(TYPE_TAG_INT),
+          value(intVal) {}
     ConstantLoadInsn(Operand lhs, BasicBlock &currentBB, double doubleVal)
-        : NonTerminatorInsn(std::move(lhs), currentBB), typeTag(TYPE_TAG_FLOAT), value(doubleVal) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_CONST_LOAD), typeTag(TYPE_TAG_FLOAT),
+          value(doubleVal) {}
     ConstantLoadInsn(Operand lhs, BasicBlock &currentBB, bool boolVal)
-        : NonTerminatorInsn(std::move(lhs), currentBB), typeTag(TYPE_TAG_BOOLEAN), value(boolVal) {}
-    ConstantLoadInsn(Operand lhs, BasicBlock &currentBB, std::string str)
-        : NonTerminatorInsn(std::move(lhs), currentBB), typeTag(TYPE_TAG_STRING), value(std::move(str)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_CONST_LOAD), typeTag(TYPE_TAG_BOOLEAN),
+          value(boolVal) {}
+    ConstantLoadInsn(Operand lhs, BasicBlock &currentBB, std::string_view str)
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_CONST_LOAD), typeTag(TYPE_TAG_STRING),
+          value(str) {}
     ConstantLoadInsn(Operand lhs, BasicBlock &currentBB)
-        : NonTerminatorInsn(std::move(lhs), currentBB), typeTag(TYPE_TAG_NIL) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_CONST_LOAD), typeTag(TYPE_TAG_NIL) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
@@ -19,14 +19,18 @@
 #ifndef __FUNCTION__H__
 #define __FUNCTION__H__
 
+#include "bir/Arena.h"
 #include "bir/BasicBlock.h"
 #include "bir/FunctionParam.h"
+#include "bir/InvocableType.h"
 #include "bir/Operand.h"
 #include "bir/RestParam.h"
 #include "bir/Variable.h"
 #include "interfaces/Debuggable.h"
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace nballerina {
@@ -39,34 +43,61 @@ class Function : public Debuggable {
     static constexpr unsigned int PUBLIC = 1;
     static constexpr unsigned int NATIVE = PUBLIC << 1;
     Package *parentPackage;
-    std::string name;
-    std::string workerName;
+    // Owns the basic blocks and instructions of this function
+    Arena arena;
+    std::string_view name;
+    std::string_view workerName;
     unsigned int flags;
+    // Signature from the function table, known before the body is decoded
+    std::optional<InvocableType> signature;
     std::optional<Variable> returnVar;
     std::optional<RestParam> restParam;
     std::vector<Variable> localVars;
-    std::vector<BasicBlock> basicBlocks;
+    // Name to position in localVars, used to resolve operands while reading
+    std::unordered_map<std::string_view, uint32_t> localVarIndices;
+    std::vector<BasicBlock *> basicBlocks;
     std::vector<FunctionParam> requiredParams;
+    void adoptBasicBlocks();
 
   public:
-    Function(Package *parentPackage, std::string name, std::string workerName, unsigned int flags);
+    Function(Package *parentPackage, std::string_view name, std::string_view workerName, unsigned int flags);
     Function(const Function &) = delete;
-    Function(Function &&) noexcept = default;
+    // Basic blocks point back at their function, so moves re-parent them
+    Function(Function &&other) noexcept;
     Function &operator=(const Function &) = delete;
-    Function &operator=(Function &&) noexcept = default;
+    Function &operator=(Function &&other) noexcept;
 
-    const std::string &getName() const;
+    std::string_view getName() const;
     size_t getNumParams() const;
     const std::optional<RestParam> &getRestParam() const;
     const std::optional<Variable> &getReturnVar() const;
-    const Variable &getLocalVariable(const std::string &opName) const;
+    const Variable &getLocalVariable(std::string_view opName) const;
+    uint32_t getLocalVarIndex(std::string_view opName) const;
+    uint32_t getVariableIndex(std::string_view opName, VarKind kind) const;
     const Variable &getLocalOrGlobalVariable(const Operand &op) const;
     bool isMainFunction() const;
     bool isExternalFunction() const;
+    bool isPublicFunction() const;
+    // Number of BIR instructions, terminators included
+    size_t getInstructionCount() const;
+    // Names of the functions called from the body, in block order
+    std::vector<std::string_view> getCalleeNames() const;
     const std::vector<FunctionParam> &getParams() const;
+    const std::optional<InvocableType> &getSignature() const;
+    // Frees the decoded body. The name, flags and signature stay, so the
+    // function can still be declared and called.
+    void releaseBody();
+    Arena &getArena();
+    const Arena &getArena() const;
 
     friend class FunctionCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
+    friend class CompilerStats;
+    template <typename ParserT>
     friend class BIRReadFunction;
+    friend class BIRReadFunctionBody;
+    template <typename ParserT>
     friend class BIRReadBasicBlock;
 };
 } // namespace nballerina
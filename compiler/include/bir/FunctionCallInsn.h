@@ -21,26 +21,28 @@
 
 #include "bir/RestParam.h"
 #include "interfaces/TerminatorInsn.h"
-#include <string>
+#include <string_view>
 #include <vector>
 
 namespace nballerina {
 
-class FunctionCallInsn : public TerminatorInsn, public Translatable<FunctionCallInsn> {
+class FunctionCallInsn : public TerminatorInsn {
   private:
-    std::string functionName;
+    std::string_view functionName;
     int argCount;
     std::vector<Operand> argsList;
 
   public:
-    FunctionCallInsn(BasicBlock &currentBB, std::string thenBBID, Operand lhs, std::string functionName, int argCount,
-                     std::vector<Operand> argsList)
-        : TerminatorInsn(std::move(lhs), currentBB, std::move(thenBBID)), functionName(std::move(functionName)),
-          argCount(argCount), argsList(std::move(argsList)) {
-        kind = INSTRUCTION_KIND_CALL;
-    }
+    FunctionCallInsn(BasicBlock &currentBB, std::string_view thenBBID, Operand lhs, std::string_view functionName,
+                     int argCount, std::vector<Operand> argsList)
+        : TerminatorInsn(std::move(lhs), currentBB, thenBBID, INSTRUCTION_KIND_CALL), functionName(functionName),
+          argCount(argCount), argsList(std::move(argsList)) {}
+
+    std::string_view getFunctionName() const { return functionName; }
 
     friend class TerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
@@ -28,11 +28,11 @@ namespace nballerina {
 
 class FunctionParam : public Operand {
   private:
-    Type type;
+    const Type *type;
 
   public:
-    FunctionParam(Operand paramOp, Type type) : Operand(std::move(paramOp)), type(std::move(type)) {}
-    const Type &getType() const { return type; }
+    FunctionParam(Operand paramOp, const Type &type) : Operand(std::move(paramOp)), type(&type) {}
+    const Type &getType() const { return *type; }
 };
 
 } // namespace nballerina
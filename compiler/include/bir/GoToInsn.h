@@ -23,12 +23,10 @@
 
 namespace nballerina {
 
-class GoToInsn : public TerminatorInsn, public Translatable<GoToInsn> {
+class GoToInsn : public TerminatorInsn {
   public:
-    GoToInsn(BasicBlock &currentBB, std::string thenBBID)
-        : TerminatorInsn(Operand("", NOT_A_KIND), currentBB, std::move(thenBBID)) {
-        kind = INSTRUCTION_KIND_GOTO;
-    }
+    GoToInsn(BasicBlock &currentBB, std::string_view thenBBID)
+        : TerminatorInsn(Operand("", NOT_A_KIND), currentBB, thenBBID, INSTRUCTION_KIND_GOTO) {}
     friend class TerminatorInsnCodeGen;
 };
 
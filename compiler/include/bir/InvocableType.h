@@ -29,13 +29,17 @@ class Type;
 
 class InvocableType {
   private:
-    std::vector<Type> paramTypes;
-    Type returnType;
-    std::optional<Type> restType;
+    std::vector<const Type *> paramTypes;
+    const Type *returnType;
+    const Type *restType;
 
   public:
-    InvocableType(std::vector<Type> paramTy, Type restTy, Type retTy);
-    InvocableType(std::vector<Type> paramTy, Type retTy);
+    InvocableType(std::vector<const Type *> paramTy, const Type &restTy, const Type &retTy);
+    InvocableType(std::vector<const Type *> paramTy, const Type &retTy);
+
+    const std::vector<const Type *> &getParamTypes() const;
+    const Type &getReturnType() const;
+    const Type *getRestType() const;
 };
 
 } // namespace nballerina
@@ -19,13 +19,13 @@
 #ifndef __LOCATION__H__
 #define __LOCATION__H__
 
-#include <string>
+#include <string_view>
 
 namespace nballerina {
 
 class Location {
   private:
-    std::string fileName;
+    std::string_view fileName;
     int sLine;
     int sCol;
     int eLine;
@@ -33,9 +33,9 @@ class Location {
 
   public:
     Location() = default;
-    Location(std::string name, int sline, int scol, int eline, int ecol);
+    Location(std::string_view name, int sline, int scol, int eline, int ecol);
 
-    const std::string &getFileName() const;
+    std::string_view getFileName() const;
     int getStartLineNum() const;
     int getStartColumnNum() const;
     int getEndLineNum() const;
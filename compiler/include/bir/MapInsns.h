@@ -58,26 +58,32 @@ class MapConstruct {
     const std::variant<KeyValue, SpreadField> &getInitValStruct() const { return initValueStruct; }
 };
 
-class MapStoreInsn : public NonTerminatorInsn, public Translatable<MapStoreInsn> {
+class MapStoreInsn : public NonTerminatorInsn {
   private:
     Operand keyOp;
     Operand rhsOp;
 
   public:
     MapStoreInsn(Operand lhs, BasicBlock &currentBB, Operand KOp, Operand ROp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), keyOp(std::move(KOp)), rhsOp(std::move(ROp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_MAP_STORE), keyOp(std::move(KOp)),
+          rhsOp(std::move(ROp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
-class MapLoadInsn : public NonTerminatorInsn, public Translatable<MapLoadInsn> {
+class MapLoadInsn : public NonTerminatorInsn {
   private:
     Operand keyOp;
     Operand rhsOp;
 
   public:
     MapLoadInsn(Operand lhs, BasicBlock &currentBB, Operand KOp, Operand ROp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), keyOp(std::move(KOp)), rhsOp(std::move(ROp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_MAP_LOAD), keyOp(std::move(KOp)),
+          rhsOp(std::move(ROp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 } // namespace nballerina
 
@@ -23,14 +23,16 @@
 
 namespace nballerina {
 
-class MoveInsn : public NonTerminatorInsn, public Translatable<MoveInsn> {
+class MoveInsn : public NonTerminatorInsn {
   private:
     Operand rhsOp;
 
   public:
     MoveInsn(Operand lhs, BasicBlock &currentBB, Operand rhsOp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), rhsOp(std::move(rhsOp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_MOVE), rhsOp(std::move(rhsOp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
@@ -20,13 +20,23 @@
 #define __OPERAND__H__
 
 #include "interfaces/AbstractVariable.h"
-#include <string>
+#include <cstdint>
+#include <string_view>
 
 namespace nballerina {
 
+static constexpr uint32_t INVALID_VAR_INDEX = UINT32_MAX;
+
 class Operand : public AbstractVariable {
+  private:
+    // Position of the referenced variable in the function locals or the
+    // package globals (depending on the kind), resolved by the reader
+    uint32_t index;
+
   public:
-    Operand(std::string name, VarKind kind) : AbstractVariable(std::move(name), kind) {}
+    Operand(std::string_view name, VarKind kind, uint32_t index = INVALID_VAR_INDEX)
+        : AbstractVariable(name, kind), index(index) {}
+    uint32_t getIndex() const { return index; }
 };
 
 } // namespace nballerina
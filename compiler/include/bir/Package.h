@@ -20,8 +20,14 @@
 #define __PACKAGE__H__
 
 #include "bir/Function.h"
+#include "bir/SymbolTable.h"
+#include "bir/TypeTable.h"
 #include "bir/Variable.h"
+#include <llvm/Support/MemoryBuffer.h>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace nballerina {
@@ -33,8 +39,15 @@ class Package {
     std::string name;
     std::string version;
     std::string sourceFileName;
+    // Package cache file the strings of a cached package point into
+    std::unique_ptr<llvm::MemoryBuffer> backingBuffer;
+    SymbolTable symbols;
+    TypeTable types;
     std::vector<Variable> globalVars;
     std::vector<Function> functions;
+    // Name to position in globalVars and functions
+    std::unordered_map<std::string_view, uint32_t> globalVarIndices;
+    std::unordered_map<std::string_view, uint32_t> functionIndices;
 
   public:
     Package() = default;
@@ -44,12 +57,31 @@ class Package {
     Package &operator=(Package &&) noexcept = delete;
 
     std::string getModuleName() const;
-    const Function &getFunction(const std::string &name) const;
-    const Variable &getGlobalVariable(const std::string &name) const;
+    const Function &getFunction(std::string_view name) const;
+    const Variable &getGlobalVariable(std::string_view name) const;
+    const Variable &getGlobalVariableAt(uint32_t index) const;
+    uint32_t getGlobalVarIndex(std::string_view name) const;
+    SymbolTable &getSymbolTable();
+    TypeTable &getTypeTable();
+    const TypeTable &getTypeTable() const;
+    // Bytes held by the function arenas, i.e. the size of the decoded IR
+    size_t getArenaBytes() const;
+    // The arenas plus the interned names, what decoding the package allocated
+    size_t getAllocatedBytes() const;
+    // Whether the package was loaded from the package cache, not decoded
+    bool isFromPackageCache() const;
 
     friend class PackageCodeGen;
+    friend class FunctionCache;
+    friend class CompilerStats;
+    friend class CodeGenerator;
+    template <typename ParserT>
     friend class BIRReadPackage;
+    template <typename ParserT>
     friend class BIRReadFunction;
+    friend class BIRReadFunctionBody;
+    friend class BIRFunctionStream;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
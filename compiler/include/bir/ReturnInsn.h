@@ -23,9 +23,10 @@
 
 namespace nballerina {
 
-class ReturnInsn : public TerminatorInsn, public Translatable<ReturnInsn> {
+class ReturnInsn : public TerminatorInsn {
   public:
-    ReturnInsn(class BasicBlock &currentBB) : TerminatorInsn(Operand("", NOT_A_KIND), currentBB, "") {}
+    ReturnInsn(class BasicBlock &currentBB)
+        : TerminatorInsn(Operand("", NOT_A_KIND), currentBB, "", INSTRUCTION_KIND_RETURN) {}
     friend class TerminatorInsnCodeGen;
 };
 
@@ -27,15 +27,19 @@ namespace nballerina {
 class Operand;
 class MapConstruct;
 
-class StructureInsn : public NonTerminatorInsn, public Translatable<StructureInsn> {
+class StructureInsn : public NonTerminatorInsn {
   private:
     std::vector<MapConstruct> initValues;
 
   public:
-    StructureInsn(Operand lhs, BasicBlock &currentBB) : NonTerminatorInsn(std::move(lhs), currentBB) {}
+    StructureInsn(Operand lhs, BasicBlock &currentBB)
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_NEW_STRUCTURE) {}
     StructureInsn(Operand lhs, BasicBlock &currentBB, std::vector<MapConstruct> initValues)
-        : NonTerminatorInsn(std::move(lhs), currentBB), initValues(std::move(initValues)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_NEW_STRUCTURE),
+          initValues(std::move(initValues)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
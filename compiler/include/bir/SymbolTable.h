@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __SYMBOLTABLE__H__
+#define __SYMBOLTABLE__H__
+
+#include <llvm/Support/Allocator.h>
+#include <llvm/Support/StringSaver.h>
+#include <string_view>
+
+namespace nballerina {
+
+// Owns the characters of every name used by a package. Each distinct string
+// is stored once and handed out as a view that is valid for the lifetime of
+// the table.
+class SymbolTable {
+  private:
+    llvm::BumpPtrAllocator allocator;
+    llvm::UniqueStringSaver saver;
+
+  public:
+    SymbolTable();
+    SymbolTable(const SymbolTable &) = delete;
+    SymbolTable(SymbolTable &&) noexcept = delete;
+    SymbolTable &operator=(const SymbolTable &) = delete;
+    SymbolTable &operator=(SymbolTable &&) noexcept = delete;
+    ~SymbolTable() = default;
+
+    std::string_view intern(std::string_view str);
+    // Bytes handed out to interned strings, excluding slab slack
+    size_t getBytesAllocated() const;
+};
+
+} // namespace nballerina
+
+#endif //!__SYMBOLTABLE__H__
@@ -25,14 +25,16 @@ namespace nballerina {
 
 class Operand;
 
-class TypeCastInsn : public NonTerminatorInsn, public Translatable<TypeCastInsn> {
+class TypeCastInsn : public NonTerminatorInsn {
   private:
     Operand rhsOp;
 
   public:
     TypeCastInsn(Operand lhs, BasicBlock &currentBB, Operand rhsOp)
-        : NonTerminatorInsn(std::move(lhs), currentBB), rhsOp(std::move(rhsOp)) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_TYPE_CAST), rhsOp(std::move(rhsOp)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
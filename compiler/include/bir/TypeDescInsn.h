@@ -23,10 +23,12 @@
 
 namespace nballerina {
 
-class TypeDescInsn : public NonTerminatorInsn, public Translatable<TypeDescInsn> {
+class TypeDescInsn : public NonTerminatorInsn {
   public:
-    TypeDescInsn(Operand lhs, BasicBlock &currentBB) : NonTerminatorInsn(std::move(lhs), currentBB){};
+    TypeDescInsn(Operand lhs, BasicBlock &currentBB)
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_NEW_TYPEDESC){};
     friend class NonTerminatorInsnCodeGen;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
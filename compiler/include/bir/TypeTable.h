@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __TYPETABLE__H__
+#define __TYPETABLE__H__
+
+#include "bir/Types.h"
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace nballerina {
+
+// Owns one record per distinct type used by a package. Structurally equal
+// types are interned once and numbered densely from 0, so that later passes
+// can key side tables by Type::getIndex(). Records never move.
+class TypeTable {
+  private:
+    using TypeKey = std::tuple<TypeTag, std::string, TypeTag, int, int>;
+    std::deque<Type> types;
+    std::map<TypeKey, const Type *> index;
+    mutable std::mutex mutex;
+    static TypeKey keyOf(const Type &type);
+
+  public:
+    TypeTable() = default;
+    TypeTable(const TypeTable &) = delete;
+    TypeTable(TypeTable &&) noexcept = delete;
+    TypeTable &operator=(const TypeTable &) = delete;
+    TypeTable &operator=(TypeTable &&) noexcept = delete;
+    ~TypeTable() = default;
+
+    // intern and size are safe to call concurrently, e.g. while the reader
+    // thread of a BIRFunctionStream is still decoding function bodies
+    const Type &intern(Type type);
+    // Only valid once no more types are being interned
+    const Type &get(TypeIndex typeIndex) const;
+    size_t size() const;
+};
+
+} // namespace nballerina
+
+#endif //!__TYPETABLE__H__
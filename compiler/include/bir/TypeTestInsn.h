@@ -23,11 +23,13 @@
 
 namespace nballerina {
 
-class TypeTestInsn : public NonTerminatorInsn, public Translatable<TypeTestInsn> {
+class TypeTestInsn : public NonTerminatorInsn {
 
   public:
-    TypeTestInsn(class Operand lhs, BasicBlock &currentBB) : NonTerminatorInsn(std::move(lhs), currentBB) {}
+    TypeTestInsn(class Operand lhs, BasicBlock &currentBB)
+        : NonTerminatorInsn(std::move(lhs), currentBB, INSTRUCTION_KIND_TYPE_TEST) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
@@ -19,8 +19,10 @@
 #ifndef __TYPEDECL__H__
 #define __TYPEDECL__H__
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 
 namespace nballerina {
@@ -81,6 +83,10 @@ enum TypeTag {
     TYPE_TAG_PARAMETERIZED_TYPE = 52
 };
 
+// Dense index of an interned type, see TypeTable
+using TypeIndex = uint32_t;
+static constexpr TypeIndex INVALID_TYPE_INDEX = UINT32_MAX;
+
 class Type {
   public:
     struct ArrayType {
@@ -94,6 +100,7 @@ class Type {
 
   private:
     TypeTag type;
+    TypeIndex index = INVALID_TYPE_INDEX;
     std::string name;
     std::variant<ArrayType, MapType> typeInfo;
 
@@ -103,12 +110,18 @@ class Type {
     Type(TypeTag type, std::string namep, MapType mapType);
 
     TypeTag getTypeTag() const;
+    // INVALID_TYPE_INDEX unless the type came from a TypeTable
+    TypeIndex getIndex() const;
+    std::string_view getName() const;
     TypeTag getMemberTypeTag() const;
+    const ArrayType &getArrayType() const;
     static std::string getNameOfType(TypeTag typeTag);
     static std::string_view typeStringMangleName(const Type &type);
     static bool isBalValueType(TypeTag typeTag);
     static bool isBoxValueSupport(TypeTag typeTag);
     static void checkMapSupport(TypeTag typeTag);
+
+    friend class TypeTable;
 };
 
 } // namespace nballerina
@@ -25,15 +25,16 @@ namespace nballerina {
 
 class Operand;
 
-class UnaryOpInsn : public NonTerminatorInsn, public Translatable<UnaryOpInsn> {
+class UnaryOpInsn : public NonTerminatorInsn {
   private:
     Operand rhsOp;
-    InstructionKind kind;
 
   public:
     UnaryOpInsn(Operand lhs, BasicBlock &currentBB, Operand rhs, InstructionKind kind)
-        : NonTerminatorInsn(std::move(lhs), currentBB), rhsOp(std::move(rhs)), kind(kind) {}
+        : NonTerminatorInsn(std::move(lhs), currentBB, kind), rhsOp(std::move(rhs)) {}
     friend class NonTerminatorInsnCodeGen;
+    friend class FunctionCache;
+    friend class PackageCache;
 };
 
 } // namespace nballerina
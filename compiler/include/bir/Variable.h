@@ -28,13 +28,13 @@ namespace nballerina {
 
 class Variable : public AbstractVariable {
   private:
-    Type type;
+    const Type *type;
 
   public:
-    Variable(Type type, std::string name, VarKind kind)
-        : AbstractVariable(std::move(name), kind), type(std::move(type)) {}
+    // type is an interned record from the package TypeTable
+    Variable(const Type &type, std::string_view name, VarKind kind) : AbstractVariable(name, kind), type(&type) {}
 
-    const Type &getType() const { return type; }
+    const Type &getType() const { return *type; }
     bool isParamter() const {
         switch (kind) {
         case ARG_VAR_KIND:
@@ -20,13 +20,17 @@
 #define __BASICBLOCKCODEGEN__H__
 
 #include "codegen/FunctionCodeGen.h"
+#include "codegen/NonTerminatorInsnCodeGen.h"
+#include "codegen/TerminatorInsnCodeGen.h"
 
 namespace nballerina {
 
+// Translates the blocks of one function. A single instance (and its
+// instruction generators) is reused for every block of the function.
 class BasicBlockCodeGen {
   private:
-    FunctionCodeGen &functionGenerator;
-    PackageCodeGen &moduleGenerator;
+    NonTerminatorInsnCodeGen nonTerminatorGenerator;
+    TerminatorInsnCodeGen terminatorGenerator;
 
   public:
     BasicBlockCodeGen() = delete;
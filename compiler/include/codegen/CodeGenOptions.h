@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __CODEGENOPTIONS__H__
+#define __CODEGENOPTIONS__H__
+
+#include <string>
+#include <vector>
+
+namespace nballerina {
+
+enum OutputKind {
+    OUTPUT_KIND_LLVM_IR = 0,
+    OUTPUT_KIND_OBJECT = 1,
+    OUTPUT_KIND_ASSEMBLY = 2,
+    // Bitcode with a ThinLTO summary, for linking with -flto=thin
+    OUTPUT_KIND_BITCODE = 3
+};
+
+// File extension for the output kind, including the dot
+inline const char *getOutputExtension(OutputKind outputKind) {
+    switch (outputKind) {
+    case OUTPUT_KIND_OBJECT:
+        return ".o";
+    case OUTPUT_KIND_ASSEMBLY:
+        return ".s";
+    case OUTPUT_KIND_BITCODE:
+        return ".bc";
+    default:
+        return ".ll";
+    }
+}
+
+struct CodeGenOptions {
+    // 0 to 3, like clang's -O levels. 0 writes the module as translated.
+    unsigned optLevel = 0;
+    // Textual LLVM IR, or native code for the module's target triple
+    OutputKind outputKind = OUTPUT_KIND_LLVM_IR;
+    // Above 1, the functions are split into this many modules that are
+    // generated and written in parallel, one file each
+    unsigned partitions = 1;
+    // Reuse per function fragments from this directory, see FunctionCache
+    std::string cacheDirectory;
+    // Static libraries that provide the runtime when the module is run in
+    // process (see JITRunner)
+    std::vector<std::string> runtimeLibraries;
+    // Describe JIT compiled functions to perf (jitdump and /tmp/perf-<pid>.map)
+    bool perfMap = false;
+};
+
+} // namespace nballerina
+
+#endif //!__CODEGENOPTIONS__H__
@@ -26,6 +26,19 @@
 
 namespace nballerina {
 
+// Runtime (and generated helper) functions called from the translated code
+enum RuntimeFunction {
+    RUNTIME_FUNCTION_STRING_INIT,
+    RUNTIME_FUNCTION_ARRAY_INIT,
+    RUNTIME_FUNCTION_ARRAY_STORE,
+    RUNTIME_FUNCTION_ARRAY_LOAD,
+    RUNTIME_FUNCTION_MAP_CREATE,
+    RUNTIME_FUNCTION_MAP_LOAD,
+    RUNTIME_FUNCTION_MAP_STORE,
+    RUNTIME_FUNCTION_MAP_SPREAD_FIELD_INIT,
+    RUNTIME_FUNCTION_ANY_TO_INT
+};
+
 class CodeGenUtils {
   private:
     CodeGenUtils() = default;
@@ -53,6 +66,13 @@ class CodeGenUtils {
     static llvm::FunctionCallee getNewMapInitFunc(llvm::Module &module);
     static llvm::FunctionCallee getMapLoadFunc(llvm::Module &module);
     static llvm::FunctionCallee getMapStoreFunc(llvm::Module &module);
+    // Declares the runtime function in the module, memberTypeTag selects the
+    // array variant. Callers should go through PackageCodeGen, which caches it.
+    static llvm::FunctionCallee getRuntimeFunction(llvm::Module &module, RuntimeFunction function,
+                                                   TypeTag memberTypeTag);
+    // Rewrites the entry block allocas that are only loaded and stored into
+    // SSA values (with phis where control flow merges)
+    static void promoteStackSlots(llvm::Function &function);
 };
 
 } // namespace nballerina
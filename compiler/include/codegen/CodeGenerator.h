@@ -19,18 +19,63 @@
 #ifndef __CODEGENERATOR__H__
 #define __CODEGENERATOR__H__
 
-#include "interfaces/Translatable.h"
+#include "codegen/CodeGenOptions.h"
+#include "codegen/FunctionCache.h"
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+#include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 
 namespace nballerina {
 
 class CodeGenerator {
   private:
+    friend class JITRunner;
     CodeGenerator() = default;
+    static void translate(class Package &translatableObj, llvm::Module &mod,
+                          const struct ModulePartition *partition = nullptr);
+    static void setTarget(llvm::Module &mod);
+    static int writeModule(llvm::Module &mod, const std::string &outFileName, const CodeGenOptions &options);
+    static int generatePartitions(class Package &translatableObj, const std::string &outFileName,
+                                  const CodeGenOptions &options);
+    static void optimize(llvm::Module &mod, unsigned optLevel, llvm::TargetMachine *targetMachine,
+                         llvm::raw_ostream *thinLTOBitcode);
+    static std::unique_ptr<llvm::TargetMachine> createTargetMachine(const llvm::Module &mod, unsigned optLevel,
+                                                                    std::string &errorMessage);
 
   public:
     ~CodeGenerator() = default;
-    static int generateLLVMIR(class Package &translatableObj, const std::string &outFileName);
+    // Registers the native target, done once per process
+    static void initializeNativeTarget();
+    // File that partition index is written to, e.g. foo.1.o for foo.o
+    static std::string partitionFileName(const std::string &outFileName, unsigned index);
+    // Translates the package and writes it to outFileName as LLVM IR, ThinLTO
+    // bitcode, or a native object or assembly file depending on
+    // options.outputKind
+    static int generateLLVMIR(class Package &translatableObj, const std::string &outFileName,
+                              const CodeGenOptions &options = {});
+    // Generates the module in a caller owned context, which lets a worker
+    // thread reuse one context across packages
+    static int generateLLVMIR(class Package &translatableObj, const std::string &outFileName,
+                              llvm::LLVMContext &mContext, const CodeGenOptions &options = {});
+    // Translates the package as its function bodies arrive from
+    // nextFunction, which returns nullptr after the last one. Every function
+    // is declared up front from its signature and the body of each is
+    // released as soon as it is lowered.
+    static int generateStreamed(class Package &translatableObj, const std::function<class Function *()> &nextFunction,
+                                const std::string &outFileName, const CodeGenOptions &options = {});
+    // Translates the package iterations times without writing it out and
+    // returns the average wall time in milliseconds and the LLVM instructions
+    // generated per second
+    static std::pair<double, double> measureThroughput(class Package &translatableObj, unsigned iterations);
+    // Compiles each function to its own fragment in options.cacheDirectory,
+    // reusing the fragments of unchanged functions, and writes the paths of
+    // all fragments to responseFileName for the linker
+    static int generateCached(class Package &translatableObj, const std::string &responseFileName,
+                              const CodeGenOptions &options, CacheStats &stats);
 };
 
 } // namespace nballerina
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __FUNCTIONCACHE__H__
+#define __FUNCTIONCACHE__H__
+
+#include "codegen/CodeGenOptions.h"
+#include <llvm/Support/MD5.h>
+#include <string>
+#include <string_view>
+
+namespace nballerina {
+
+class Function;
+class Package;
+class Type;
+class Operand;
+class NonTerminatorInsn;
+class TerminatorInsn;
+
+struct CacheStats {
+    unsigned hits = 0;
+    unsigned misses = 0;
+};
+
+// On disk cache of per function object (or bitcode, ...) fragments. A
+// fragment is keyed by a hash of the function body, the types it uses, the
+// signatures of its callees and the options it was compiled with, so it is
+// only regenerated when one of those changes.
+class FunctionCache {
+  private:
+    std::string directory;
+    std::string extension;
+    // Hash of the compiler and options, mixed into every key
+    std::string optionsKey;
+    static void hashString(llvm::MD5 &hash, std::string_view value);
+    static void hashInteger(llvm::MD5 &hash, uint64_t value);
+    static void hashType(llvm::MD5 &hash, const Type &type);
+    static void hashOperand(llvm::MD5 &hash, const Package &package, const Operand &operand);
+    static void hashSignature(llvm::MD5 &hash, const Function &function);
+    static void hashInstruction(llvm::MD5 &hash, const Package &package, const NonTerminatorInsn &insn);
+    static void hashTerminator(llvm::MD5 &hash, const Package &package, const TerminatorInsn &insn);
+    std::string finalizeKey(llvm::MD5 &hash) const;
+
+  public:
+    FunctionCache() = delete;
+    FunctionCache(std::string directory, const CodeGenOptions &options);
+    ~FunctionCache() = default;
+
+    // Creates the cache directory if needed, returns false if it can not
+    bool open() const;
+    std::string getFunctionKey(const Package &package, const Function &function) const;
+    // Key of the fragment that defines the package global variables
+    std::string getGlobalsKey(const Package &package) const;
+    std::string getFragmentPath(const std::string &key) const;
+    bool contains(const std::string &key) const;
+};
+
+} // namespace nballerina
+
+#endif //!__FUNCTIONCACHE__H__
@@ -20,8 +20,9 @@
 #define __FUNCTIONCODEGEN__H__
 
 #include "codegen/PackageCodeGen.h"
-#include <map>
-#include <string>
+#include <cstdint>
+#include <string_view>
+#include <vector>
 
 namespace nballerina {
 
@@ -31,8 +32,9 @@ class Function;
 class FunctionCodeGen {
   private:
     PackageCodeGen &parentGenerator;
-    std::map<std::string, llvm::BasicBlock *> basicBlocksMap;
-    std::map<std::string, llvm::AllocaInst *> localVarRefs;
+    // Indexed by the positions the reader resolved for blocks and locals
+    std::vector<llvm::BasicBlock *> basicBlocks;
+    std::vector<llvm::AllocaInst *> localVarRefs;
     llvm::Function *llvmFunction;
 
   public:
@@ -40,10 +42,13 @@ class FunctionCodeGen {
     FunctionCodeGen(PackageCodeGen &parentGenerator);
     ~FunctionCodeGen() = default;
 
-    llvm::BasicBlock *getBasicBlock(const std::string &id);
-    llvm::AllocaInst *getLocalVal(const std::string &varName) const;
+    llvm::BasicBlock *getBasicBlock(uint32_t index) const;
+    llvm::AllocaInst *getLocalVal(uint32_t index) const;
     llvm::Value *getLocalOrGlobalVal(const Operand &op) const;
     llvm::Value *createTempVal(const Operand &op, llvm::IRBuilder<> &builder) const;
+    // Stack slots are only created in the entry block, so that they are
+    // allocated once per call and can be promoted to SSA values
+    llvm::AllocaInst *createEntryAlloca(llvm::Type *type, const llvm::Twine &name = "");
     static llvm::Type *getRetValType(const Function &obj, llvm::Module &module);
     llvm::Function *getFunctionValue();
 
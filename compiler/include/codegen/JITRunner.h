@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __JITRUNNER__H__
+#define __JITRUNNER__H__
+
+#include "codegen/CodeGenOptions.h"
+
+namespace nballerina {
+
+// Compiles a package with ORC LLJIT and runs its main function in this
+// process, resolving the runtime from options.runtimeLibraries
+class JITRunner {
+  private:
+    JITRunner() = default;
+
+  public:
+    ~JITRunner() = default;
+    // Returns 0 once main returns, or -1 if the module could not be JIT
+    // compiled
+    static int run(class Package &translatableObj, const CodeGenOptions &options = {});
+};
+
+} // namespace nballerina
+
+#endif //!__JITRUNNER__H__
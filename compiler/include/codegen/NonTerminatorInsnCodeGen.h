@@ -20,13 +20,10 @@
 #define __NONTERMINATORINSNCODEGEN__H__
 
 #include "codegen/FunctionCodeGen.h"
-#include "interfaces/Translatable.h"
 
 namespace nballerina {
-class NonTerminatorInsnCodeGen
-    : public Translators<class ConstantLoadInsn, class TypeCastInsn, class StructureInsn, class BinaryOpInsn,
-                         class MapStoreInsn, class MapLoadInsn, class ArrayInsn, class ArrayStoreInsn,
-                         class ArrayLoadInsn, class UnaryOpInsn, class MoveInsn> {
+
+class NonTerminatorInsnCodeGen {
   private:
     FunctionCodeGen &functionGenerator;
     PackageCodeGen &moduleGenerator;
@@ -38,17 +35,19 @@ class NonTerminatorInsnCodeGen
     NonTerminatorInsnCodeGen(FunctionCodeGen &functionGenerator, PackageCodeGen &moduleGenerator)
         : functionGenerator(functionGenerator), moduleGenerator(moduleGenerator) {}
     ~NonTerminatorInsnCodeGen() = default;
-    void visit(class ArrayInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class ArrayStoreInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class ArrayLoadInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class BinaryOpInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class ConstantLoadInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class MapLoadInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class MapStoreInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class MoveInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class StructureInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class TypeCastInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class UnaryOpInsn &obj, llvm::IRBuilder<> &builder) override;
+    // Dispatches on the instruction kind to one of the overloads below
+    void visit(class NonTerminatorInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class ArrayInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class ArrayStoreInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class ArrayLoadInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class BinaryOpInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class ConstantLoadInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class MapLoadInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class MapStoreInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class MoveInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class StructureInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class TypeCastInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class UnaryOpInsn &obj, llvm::IRBuilder<> &builder);
 };
 
 } // namespace nballerina
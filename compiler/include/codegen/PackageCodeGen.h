@@ -20,12 +20,24 @@
 #define __PACKAGECODEGEN__H__
 
 #include "bir/Types.h"
+#include "codegen/CodeGenUtils.h"
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/MC/StringTableBuilder.h>
+#include <functional>
+#include <vector>
 
 namespace nballerina {
 
+// A group of functions whose bodies are generated into one module. The other
+// functions of the package are only declared there, and so are the global
+// variables unless definesGlobals is set.
+struct ModulePartition {
+    std::vector<uint32_t> functionIndices;
+    bool definesGlobals = false;
+};
+
 class PackageCodeGen {
   private:
     inline static const std::string BAL_NIL_VALUE = "bal_nil_value";
@@ -34,8 +46,21 @@ class PackageCodeGen {
     llvm::GlobalVariable *globalStrTable;
     llvm::GlobalVariable *globalStrTable2;
     std::unique_ptr<llvm::StringTableBuilder> strBuilder;
-    std::map<std::string, std::vector<llvm::Value *>> structElementStoreInst;
+    // String table lookups whose offset is only known once the table is
+    // finalized, in the order they were generated
+    std::vector<std::pair<llvm::StringRef, llvm::GetElementPtrInst *>> stringOffsetFixups;
+    // LLVM type of each interned BIR type, indexed by Type::getIndex()
+    std::vector<llvm::Type *> llvmTypes;
+    // Indexed like the package global variables
+    std::vector<llvm::GlobalVariable *> globalVarRefs;
+    // Declared runtime functions, keyed by RuntimeFunction and member type tag
+    llvm::DenseMap<std::pair<unsigned, unsigned>, llvm::FunctionCallee> runtimeFunctions;
     void applyStringOffsetRelocations(llvm::IRBuilder<> &builder);
+    void declareFunction(const class Function &function);
+    void declarePackage(class Package &obj, const ModulePartition *partition, llvm::IRBuilder<> &builder);
+    void lowerFunction(class Function &function, llvm::IRBuilder<> &builder);
+    void finalizeModule(llvm::IRBuilder<> &builder);
+    void visit(class Package &obj, const ModulePartition *partition, llvm::IRBuilder<> &builder);
 
   public:
     PackageCodeGen() = delete;
@@ -44,8 +69,20 @@ class PackageCodeGen {
 
     llvm::Module &getModule();
     llvm::Value *addToStringTable(std::string_view newString, llvm::IRBuilder<> &builder);
+    llvm::Type *getLLVMType(const Type &type);
+    llvm::GlobalVariable *getGlobalVariable(uint32_t index) const;
+    llvm::FunctionCallee getRuntimeFunction(RuntimeFunction function, TypeTag memberTypeTag = TYPE_TAG_NIL);
 
     void visit(class Package &obj, llvm::IRBuilder<> &builder);
+    void visit(class Package &obj, const ModulePartition &partition, llvm::IRBuilder<> &builder);
+    // Declares every function of the package, then lowers the functions
+    // handed out by nextFunction until it returns nullptr. The body of each
+    // function is released once it is lowered.
+    void visit(class Package &obj, const std::function<class Function *()> &nextFunction,
+               llvm::IRBuilder<> &builder);
+    // Splits the functions with a body into at most count partitions of
+    // about the same number of instructions
+    static std::vector<ModulePartition> partition(const class Package &obj, unsigned count);
 };
 
 } // namespace nballerina
@@ -20,12 +20,10 @@
 #define __TERMINATORINSNCODEGEN__H__
 
 #include "codegen/FunctionCodeGen.h"
-#include "interfaces/Translatable.h"
 
 namespace nballerina {
 
-class TerminatorInsnCodeGen
-    : public Translators<class ConditionBrInsn, class FunctionCallInsn, class GoToInsn, class ReturnInsn> {
+class TerminatorInsnCodeGen {
   private:
     FunctionCodeGen &functionGenerator;
     PackageCodeGen &moduleGenerator;
@@ -34,10 +32,12 @@ class TerminatorInsnCodeGen
     TerminatorInsnCodeGen() = delete;
     TerminatorInsnCodeGen(FunctionCodeGen &functionGenerator, PackageCodeGen &moduleGenerator);
     ~TerminatorInsnCodeGen() = default;
-    void visit(class ConditionBrInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class FunctionCallInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class GoToInsn &obj, llvm::IRBuilder<> &builder) override;
-    void visit(class ReturnInsn &obj, llvm::IRBuilder<> &builder) override;
+    // Dispatches on the instruction kind to one of the overloads below
+    void visit(class TerminatorInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class ConditionBrInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class FunctionCallInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class GoToInsn &obj, llvm::IRBuilder<> &builder);
+    void visit(class ReturnInsn &obj, llvm::IRBuilder<> &builder);
 };
 
 } // namespace nballerina
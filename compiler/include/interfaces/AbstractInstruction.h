@@ -75,10 +75,13 @@ class AbstractInstruction : public Debuggable {
 
   protected:
     Operand lhsOp;
+    // Selects the concrete instruction class, see the codegen dispatch
+    InstructionKind kind;
     const Function &getFunctionRef() const;
 
   public:
-    AbstractInstruction(Operand lOp, BasicBlock &parentBB);
+    AbstractInstruction(Operand lOp, BasicBlock &parentBB, InstructionKind kind);
+    InstructionKind getKind() const { return kind; }
     AbstractInstruction(const AbstractInstruction &) = delete;
     AbstractInstruction(AbstractInstruction &&) noexcept = delete;
     AbstractInstruction &operator=(const AbstractInstruction &) = delete;
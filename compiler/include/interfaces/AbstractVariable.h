@@ -19,7 +19,7 @@
 #ifndef __ABSTRACTVARIABLE__H__
 #define __ABSTRACTVARIABLE__H__
 
-#include <string>
+#include <string_view>
 
 namespace nballerina {
 
@@ -37,9 +37,9 @@ enum VarKind {
 
 class AbstractVariable {
   protected:
-    std::string name;
+    std::string_view name;
     VarKind kind;
-    AbstractVariable(std::string name, VarKind kind) : name(std::move(name)), kind(kind) {}
+    AbstractVariable(std::string_view name, VarKind kind) : name(name), kind(kind) {}
     AbstractVariable(const AbstractVariable &) = delete;
     AbstractVariable(AbstractVariable &&) noexcept = default;
     AbstractVariable &operator=(const AbstractVariable &) = delete;
@@ -49,7 +49,7 @@ class AbstractVariable {
     virtual ~AbstractVariable() = default;
 
     VarKind getKind() const { return kind; }
-    const std::string &getName() const { return name; };
+    std::string_view getName() const { return name; };
 };
 
 } // namespace nballerina
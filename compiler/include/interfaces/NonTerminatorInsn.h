@@ -20,13 +20,13 @@
 #define __NONTERMINATORINSN__H__
 
 #include "interfaces/AbstractInstruction.h"
-#include "interfaces/Translatable.h"
 
 namespace nballerina {
 
-class NonTerminatorInsn : public AbstractInstruction, virtual public TranslatableInterface {
+class NonTerminatorInsn : public AbstractInstruction {
   protected:
-    NonTerminatorInsn(Operand lOp, BasicBlock &currentBB) : AbstractInstruction(std::move(lOp), currentBB) {}
+    NonTerminatorInsn(Operand lOp, BasicBlock &currentBB, InstructionKind kind)
+        : AbstractInstruction(std::move(lOp), currentBB, kind) {}
 
   public:
     virtual ~NonTerminatorInsn() = default;
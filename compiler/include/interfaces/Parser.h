@@ -20,19 +20,60 @@
 #define __PARSER__H__
 
 #include <cstdint>
+#include <cstring>
 #include <ios>
+#include <llvm/Support/Endian.h>
+#include <vector>
 
 namespace nballerina {
 
+/*
+ * Static (CRTP) parser interface. A concrete parser only provides readChars()
+ * and ignore(); the big-endian decoders below are resolved at compile time so
+ * that a decoder templated on the concrete parser inlines down to a load and a
+ * byte swap.
+ */
+template <typename ParserImpl>
 class Parser {
+  private:
+    ParserImpl &impl() { return *static_cast<ParserImpl *>(this); }
+
+    template <typename T>
+    T readBigEndian() {
+        char bytes[sizeof(T)];
+        impl().readChars(bytes, sizeof(T));
+        return llvm::support::endian::read<T, llvm::support::big, llvm::support::unaligned>(bytes);
+    }
+
   public:
-    virtual uint8_t readU1() = 0;
-    virtual int16_t readS2be() = 0;
-    virtual int32_t readS4be() = 0;
-    virtual int64_t readS8be() = 0;
-    virtual double readS8bef() = 0;
-    virtual void readChars(char *outBuff, std::streamsize length) = 0;
-    virtual void ignore(std::streamsize length) = 0;
+    uint8_t readU1() { return readBigEndian<uint8_t>(); }
+    int16_t readS2be() { return readBigEndian<int16_t>(); }
+    int32_t readS4be() { return readBigEndian<int32_t>(); }
+    int64_t readS8be() { return readBigEndian<int64_t>(); }
+
+    double readS8bef() {
+        auto bits = readBigEndian<uint64_t>();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Bulk decode a list of 4 byte big-endian values
+    void readS4beArray(int32_t *outBuff, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        impl().readChars(reinterpret_cast<char *>(outBuff), count * sizeof(int32_t));
+        for (size_t i = 0; i < count; i++) {
+            outBuff[i] = llvm::support::endian::byte_swap<int32_t, llvm::support::big>(outBuff[i]);
+        }
+    }
+
+    std::vector<int32_t> readS4beList(int32_t count) {
+        std::vector<int32_t> values(count > 0 ? count : 0);
+        readS4beArray(values.data(), values.size());
+        return values;
+    }
 };
 
 } // namespace nballerina
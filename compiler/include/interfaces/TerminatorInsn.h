@@ -20,21 +20,26 @@
 #define __TERMINATORINSN__H__
 
 #include "interfaces/AbstractInstruction.h"
-#include "interfaces/Translatable.h"
-#include <string>
+#include <cstdint>
+#include <string_view>
 
 namespace nballerina {
 
-class TerminatorInsn : public AbstractInstruction, virtual public TranslatableInterface {
+static constexpr uint32_t INVALID_BB_INDEX = UINT32_MAX;
+
+class TerminatorInsn : public AbstractInstruction {
   protected:
-    std::string thenBBID;
-    InstructionKind kind;
-    TerminatorInsn(class Operand lhs, class BasicBlock &currentBB, std::string thenBBID)
-        : AbstractInstruction(std::move(lhs), currentBB), thenBBID(std::move(thenBBID)),
-          kind(INSTRUCTION_NOT_AN_INSTRUCTION) {}
+    std::string_view thenBBID;
+    // Position of the target block in the function, resolved once all blocks are read
+    uint32_t thenBBIndex;
+    TerminatorInsn(class Operand lhs, class BasicBlock &currentBB, std::string_view thenBBID, InstructionKind kind)
+        : AbstractInstruction(std::move(lhs), currentBB, kind), thenBBID(thenBBID), thenBBIndex(INVALID_BB_INDEX) {}
 
   public:
     virtual ~TerminatorInsn() = default;
+    std::string_view getThenBBID() const { return thenBBID; }
+    uint32_t getThenBBIndex() const { return thenBBIndex; }
+    void setThenBBIndex(uint32_t index) { thenBBIndex = index; }
 };
 
 } // namespace nballerina
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BIRBUFFERREADER__H__
+#define __BIRBUFFERREADER__H__
+
+#include "interfaces/Parser.h"
+#include <cstring>
+#include <llvm/ADT/StringRef.h>
+
+namespace nballerina {
+
+// Parser that decodes from a bounds checked cursor over an in-memory (typically
+// memory mapped) BIR dump. The buffer must outlive the reader.
+class BIRBufferReader final : public Parser<BIRBufferReader> {
+  private:
+    const char *cursor;
+    const char *bufferEnd;
+    [[noreturn]] void reportTruncated(std::streamsize length) const;
+    [[noreturn]] void reportNegativeLength(std::streamsize length) const;
+    void checkAvailable(std::streamsize length) const {
+        if (length < 0) {
+            reportNegativeLength(length);
+        }
+        if (length > bufferEnd - cursor) {
+            reportTruncated(length);
+        }
+    }
+
+  public:
+    BIRBufferReader(llvm::StringRef buffer);
+
+    size_t remaining() const;
+
+    void ignore(std::streamsize length) {
+        checkAvailable(length);
+        cursor += length;
+    }
+
+    void readChars(char *outBuff, std::streamsize length) {
+        checkAvailable(length);
+        std::memcpy(outBuff, cursor, length);
+        cursor += length;
+    }
+
+    // Returns a view of the next length bytes; valid for the lifetime of the buffer
+    llvm::StringRef readBlob(std::streamsize length) {
+        checkAvailable(length);
+        llvm::StringRef blob(cursor, length);
+        cursor += length;
+        return blob;
+    }
+};
+
+} // namespace nballerina
+
+#endif //!__BIRBUFFERREADER__H__
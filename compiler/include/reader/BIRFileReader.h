@@ -20,27 +20,27 @@
 #define BIRREADER_H
 
 #include "bir/Package.h"
-#include "interfaces/Parser.h"
-#include <fstream>
+#include "reader/BIRFunctionStream.h"
+#include "reader/ReaderOptions.h"
 #include <memory>
+#include <string>
 
 namespace nballerina {
 
-class BIRFileReader : public Parser {
+class BIRFileReader {
   private:
-    std::ifstream is;
-    BIRFileReader(std::string FileName);
-
-    uint8_t readU1() override;
-    int16_t readS2be() override;
-    int32_t readS4be() override;
-    int64_t readS8be() override;
-    double readS8bef() override;
-    void ignore(std::streamsize length) override;
-    void readChars(char *outBuff, std::streamsize length) override;
+    BIRFileReader() = default;
 
   public:
-    static std::shared_ptr<Package> deserialize(const std::string &FileName);
+    static std::shared_ptr<Package> deserialize(const std::string &FileName, const ReaderOptions &options = {});
+    // Reads the function table and starts decoding the function bodies in the
+    // background, see BIRFunctionStream. Reachability pruning does not apply.
+    static std::unique_ptr<BIRFunctionStream> openFunctionStream(
+        const std::string &FileName, const ReaderOptions &options = {},
+        size_t lookahead = BIRFunctionStream::DEFAULT_LOOKAHEAD);
+    // Returns the average reader throughput in MB/s over the given number of iterations. The package cache is not
+    // used, so that both readers are timed on every iteration
+    static double measureThroughput(const std::string &FileName, const ReaderOptions &options, unsigned iterations);
 };
 
 } // namespace nballerina
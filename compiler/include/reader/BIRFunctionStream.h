@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BIRFUNCTIONSTREAM__H__
+#define __BIRFUNCTIONSTREAM__H__
+
+#include "bir/Package.h"
+#include "reader/BIRReadFunction.h"
+#include "reader/BIRStreamReader.h"
+#include "reader/ConstantPool.h"
+#include <llvm/Support/MemoryBuffer.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nballerina {
+
+// A package whose function table has been read but whose function bodies
+// are decoded on a reader thread, in package order, while the consumer works
+// on the ones decoded before. The reader stays at most lookahead functions
+// ahead of the consumer.
+class BIRFunctionStream {
+  private:
+    // Whichever of the two holds the undecoded bodies
+    std::unique_ptr<llvm::MemoryBuffer> mappedFile;
+    std::unique_ptr<BIRStreamReader> streamReader;
+    std::shared_ptr<Package> package;
+    std::unique_ptr<ConstantPoolSet> cp;
+    std::vector<PendingFunctionBody> pendingBodies;
+    size_t lookahead;
+    std::mutex queueLock;
+    std::condition_variable functionDecoded;
+    std::condition_variable functionTaken;
+    std::deque<Function *> decodedFunctions;
+    bool finished = false;
+    bool stopping = false;
+    std::thread readerThread;
+    BIRFunctionStream(size_t lookahead);
+    void start();
+    void decodeBodies();
+
+  public:
+    static constexpr size_t DEFAULT_LOOKAHEAD = 4;
+    BIRFunctionStream(const BIRFunctionStream &) = delete;
+    BIRFunctionStream &operator=(const BIRFunctionStream &) = delete;
+    ~BIRFunctionStream();
+
+    Package &getPackage();
+    // Waits for the next decoded function, nullptr once all are handed out
+    Function *readNextFunction();
+
+    friend class BIRFileReader;
+};
+
+} // namespace nballerina
+
+#endif //!__BIRFUNCTIONSTREAM__H__
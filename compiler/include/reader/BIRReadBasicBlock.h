@@ -25,9 +25,10 @@
 
 namespace nballerina {
 
+template <typename ParserT>
 class BIRReadBasicBlock {
   public:
-    static void readBasicBlock(Function &birFunction, Parser &reader, ConstantPoolSet &cp, bool ignore = false);
+    static void readBasicBlock(Function &birFunction, ParserT &reader, ConstantPoolSet &cp, bool ignore = false);
 };
 
 } // namespace nballerina
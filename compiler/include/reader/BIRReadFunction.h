@@ -20,16 +20,49 @@
 
 #include "bir/Package.h"
 #include "interfaces/Parser.h"
+#include "reader/BIRBufferReader.h"
 #include "reader/ConstantPool.h"
+#include "reader/FunctionIgnoreList.h"
+#include <llvm/ADT/StringRef.h>
+#include <string>
+#include <vector>
 
 namespace nballerina {
 
-class BIRReadFunction {
+// Function whose header has been read but whose body is still undecoded
+struct PendingFunctionBody {
+    size_t functionIndex;
+    std::vector<Operand> params;
+    llvm::StringRef body;
+};
+
+// Decodes function bodies. Bodies are length prefixed and self contained, so
+// they are always decoded from memory and independently of each other.
+class BIRReadFunctionBody {
   private:
-    static void readLocalVar(Function &function, Parser &reader, ConstantPoolSet &cp);
+    static void readLocalVar(Function &function, BIRBufferReader &reader, ConstantPoolSet &cp);
+    static void resolveBranchTargets(Function &function);
 
   public:
-    static void readFunction(Package &package, Parser &reader, ConstantPoolSet &cp, bool ignore = false);
+    static void readFunctionBody(Function &function, PendingFunctionBody &pending, ConstantPoolSet &cp);
+    // Decodes the pending bodies on up to jobs threads (0 uses all hardware threads)
+    static void readFunctionBodies(Package &package, std::vector<PendingFunctionBody> &pending, ConstantPoolSet &cp,
+                                   unsigned jobs);
+    // Decodes bodies in call graph order starting from the roots (main, public
+    // functions and entryPoints) and drops the functions that are never reached
+    static void readReachableFunctionBodies(Package &package, std::vector<PendingFunctionBody> &pending,
+                                            ConstantPoolSet &cp, const std::vector<std::string> &entryPoints,
+                                            unsigned jobs);
+};
+
+template <typename ParserT>
+class BIRReadFunction {
+  public:
+    // Reads the function header and queues its body on pendingBodies. Ignored
+    // functions are recognised from their name and their body is skipped.
+    static void readFunction(Package &package, ParserT &reader, ConstantPoolSet &cp,
+                             std::vector<PendingFunctionBody> &pendingBodies, const FunctionIgnoreList &ignoreList,
+                             bool ignore = false);
 };
 
 } // namespace nballerina
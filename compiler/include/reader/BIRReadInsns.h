@@ -25,28 +25,29 @@
 
 namespace nballerina {
 
+template <typename ParserT>
 class BIRReadInsn {
   private:
-    static void ReadCondBrInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadFuncCallInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadGoToInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadReturnInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadBinaryInsn(BasicBlock &currentBB, InstructionKind kind, Parser &reader, ConstantPoolSet &cp);
-    static void ReadUnaryInsn(BasicBlock &currentBB, InstructionKind kind, Parser &reader, ConstantPoolSet &cp);
-    static void ReadConstLoadInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadMoveInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadTypeDescInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadStructureInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadTypeCastInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadTypeTestInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadArrayInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadArrayStoreInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadArrayLoadInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadMapStoreInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
-    static void ReadMapLoadInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp);
+    static void ReadCondBrInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadFuncCallInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadGoToInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadReturnInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadBinaryInsn(BasicBlock &currentBB, InstructionKind kind, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadUnaryInsn(BasicBlock &currentBB, InstructionKind kind, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadConstLoadInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadMoveInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadTypeDescInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadStructureInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadTypeCastInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadTypeTestInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadArrayInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadArrayStoreInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadArrayLoadInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadMapStoreInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
+    static void ReadMapLoadInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp);
 
   public:
-    static void readInsn(BasicBlock &basicBlock, Parser &reader, ConstantPoolSet &cp);
+    static void readInsn(BasicBlock &basicBlock, ParserT &reader, ConstantPoolSet &cp);
 };
 
 } // namespace nballerina
@@ -21,16 +21,22 @@
 
 #include "bir/Package.h"
 #include "interfaces/Parser.h"
+#include "reader/BIRReadFunction.h"
 #include "reader/ConstantPool.h"
-#include <memory>
+#include "reader/ReaderOptions.h"
+#include <vector>
 
 namespace nballerina {
+template <typename ParserT>
 class BIRReadPackage {
   private:
-    static void readGlobalVar(Package &birPackage, Parser &reader, ConstantPoolSet &cp);
+    static void readGlobalVar(Package &birPackage, ParserT &reader, ConstantPoolSet &cp);
 
   public:
-    static std::shared_ptr<Package> readModule(Parser &reader, ConstantPoolSet &cp);
+    // With deferredBodies the function bodies are left undecoded and moved
+    // there, for the caller to decode
+    static void readModule(Package &birPackage, ParserT &reader, ConstantPoolSet &cp, const ReaderOptions &options,
+                           std::vector<PendingFunctionBody> *deferredBodies = nullptr);
 };
 
 } // namespace nballerina
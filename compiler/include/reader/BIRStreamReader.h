@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BIRSTREAMREADER__H__
+#define __BIRSTREAMREADER__H__
+
+#include "interfaces/Parser.h"
+#include "reader/ByteSource.h"
+#include <cstring>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
+#include <memory>
+
+namespace nballerina {
+
+// Parser that pulls each field through a fixed size buffer refilled from a
+// forward only byte source, so it works on pipes and stdin as well as files.
+class BIRStreamReader final : public Parser<BIRStreamReader> {
+  private:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+    std::unique_ptr<ByteSource> source;
+    std::unique_ptr<char[]> buffer;
+    const char *cursor;
+    const char *bufferEnd;
+    llvm::BumpPtrAllocator blobStorage;
+    size_t available() const { return bufferEnd - cursor; }
+    bool refill();
+    void readSlow(char *outBuff, std::streamsize length);
+    void ignoreSlow(std::streamsize length);
+    [[noreturn]] void reportTruncated(std::streamsize length) const;
+    [[noreturn]] void reportNegativeLength(std::streamsize length) const;
+
+  public:
+    BIRStreamReader(std::unique_ptr<ByteSource> source);
+
+    void ignore(std::streamsize length) {
+        if (length >= 0 && static_cast<size_t>(length) <= available()) {
+            cursor += length;
+            return;
+        }
+        ignoreSlow(length);
+    }
+
+    void readChars(char *outBuff, std::streamsize length) {
+        if (length >= 0 && static_cast<size_t>(length) <= available()) {
+            std::memcpy(outBuff, cursor, length);
+            cursor += length;
+            return;
+        }
+        readSlow(outBuff, length);
+    }
+
+    // Copies the next length bytes into storage owned by the reader
+    llvm::StringRef readBlob(std::streamsize length);
+};
+
+} // namespace nballerina
+
+#endif //!__BIRSTREAMREADER__H__
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BYTESOURCE__H__
+#define __BYTESOURCE__H__
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <memory>
+#include <string>
+
+namespace nballerina {
+
+// Forward only source of raw BIR bytes (file, stdin, named pipe or a
+// decompressor stacked on one of those). Sources never seek.
+class ByteSource {
+  private:
+    std::string pushedBack;
+
+  protected:
+    // Reads at most length bytes; returns 0 only at the end of the input
+    virtual size_t readSome(char *outBuff, size_t length) = 0;
+
+  public:
+    // First 4 bytes of every zstd frame
+    static constexpr llvm::StringLiteral ZSTD_MAGIC = "\x28\xB5\x2F\xFD";
+
+    ByteSource() = default;
+    ByteSource(const ByteSource &) = delete;
+    ByteSource &operator=(const ByteSource &) = delete;
+    virtual ~ByteSource() = default;
+
+    size_t read(char *outBuff, size_t length);
+    // Returns bytes so that the next read() sees them again
+    void unread(llvm::StringRef bytes);
+
+    // Opens FileName ("-" is stdin) and transparently decompresses zstd input.
+    // Returns nullptr and sets errorMessage on failure.
+    static std::unique_ptr<ByteSource> open(const std::string &FileName, std::string &errorMessage);
+};
+
+class FileByteSource final : public ByteSource {
+  private:
+    llvm::sys::fs::file_t handle;
+    bool ownsHandle;
+
+  protected:
+    size_t readSome(char *outBuff, size_t length) override;
+
+  public:
+    FileByteSource(llvm::sys::fs::file_t handle, bool ownsHandle);
+    ~FileByteSource();
+};
+
+} // namespace nballerina
+
+#endif //!__BYTESOURCE__H__
@@ -20,11 +20,16 @@
 #define __CONSTANTPOOL__H__
 
 #include "bir/InvocableType.h"
+#include "bir/SymbolTable.h"
+#include "bir/TypeTable.h"
 #include "bir/Types.h"
 #include "interfaces/Parser.h"
+#include <atomic>
 #include <cstdint>
+#include <llvm/ADT/StringRef.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace nballerina {
@@ -41,36 +46,14 @@ class ConstantPoolEntry {
         TAG_ENUM_CP_ENTRY_BYTE = 6,
         TAG_ENUM_CP_ENTRY_SHAPE = 7
     };
-    virtual ~ConstantPoolEntry() = default;
-    virtual void read(Parser &reader) = 0;
-
-  private:
-    tagEnum tag;
-
-  public:
-    tagEnum getTag() { return tag; }
-    void setTag(tagEnum t) { tag = t; }
 };
 
-class StringCpInfo : public ConstantPoolEntry {
+// Decoded shape entry. Shapes are decoded on first use from their raw bytes
+class ShapeCpInfo {
 
   public:
-    StringCpInfo();
-    void read(Parser &reader) override;
-
-  private:
-    std::string value;
-
-  public:
-    std::string getValue() { return value; }
-    void setValue(std::string str) { value = str; }
-};
-
-class ShapeCpInfo : public ConstantPoolEntry {
-
-  public:
-    ShapeCpInfo();
-    void read(Parser &reader) override;
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t shapeLength;
@@ -122,11 +105,12 @@ class ShapeCpInfo : public ConstantPoolEntry {
     void setElementTypeCpIndex(int32_t i) { elementTypeCpIndex = i; }
 };
 
-class PackageCpInfo : public ConstantPoolEntry {
+class PackageCpInfo {
 
   public:
     PackageCpInfo();
-    void read(Parser &reader) override;
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t orgIndex;
@@ -142,84 +126,55 @@ class PackageCpInfo : public ConstantPoolEntry {
     void setVersionIndex(int32_t version) { versionIndex = version; }
 };
 
-class IntCpInfo : public ConstantPoolEntry {
-
-  public:
-    IntCpInfo();
-    void read(Parser &reader) override;
-
-  private:
-    int64_t value;
-
-  public:
-    int64_t getValue() { return value; }
-    void setValue(int64_t v) { value = v; }
-};
-
-class BooleanCpInfo : public ConstantPoolEntry {
-
-  public:
-    BooleanCpInfo();
-    void read(Parser &reader) override;
-
-  private:
-    uint8_t value;
-
-  public:
-    uint8_t getValue() { return value; }
-    void setValue(uint8_t v) { value = v; }
-};
-
-class FloatCpInfo : public ConstantPoolEntry {
-
-  public:
-    FloatCpInfo();
-    void read(Parser &reader) override;
-
-  private:
-    double value;
-
-  public:
-    double getValue() { return value; }
-    void setValue(double v) { value = v; }
-};
-
-class ByteCpInfo : public ConstantPoolEntry {
-
-  public:
-    ByteCpInfo();
-    void read(Parser &reader) override;
-
-  private:
-    int32_t value;
-
-  public:
-    int32_t getValue() { return value; }
-    void setValue(int32_t v) { value = v; }
-};
-
 class ConstantPoolSet {
 
   public:
-    void read(Parser &reader);
+    ConstantPoolSet(SymbolTable &symbols, TypeTable &typeTable);
+    ConstantPoolSet(const ConstantPoolSet &) = delete;
+    ConstantPoolSet &operator=(const ConstantPoolSet &) = delete;
+    ~ConstantPoolSet();
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
-    std::vector<std::unique_ptr<ConstantPoolEntry>> poolEntries;
+    // Pool is kept as flat arrays indexed by the constant pool index. Scalars
+    // live inline in values; for strings the value is an index into strings,
+    // for packages into blobs and for shapes into shapeBlobs/shapes. Blobs
+    // point into data owned by the parser, so the pool must not outlive it.
+    std::vector<uint8_t> tags;
+    std::vector<uint64_t> values;
+    std::vector<llvm::StringRef> blobs;
+    std::vector<llvm::StringRef> shapeBlobs;
+    // Shapes are decoded on first use and published atomically, so that
+    // function bodies can be decoded concurrently against the same pool
+    std::vector<std::atomic<ShapeCpInfo *>> shapes;
+    // Strings are interned into the package symbol table while reading the pool
+    SymbolTable &symbols;
+    std::vector<std::string_view> strings;
+    // getTypeCp results, two slots (voidToInt false/true) per shape, pointing
+    // into the package type table
+    TypeTable &typeTable;
+    std::vector<std::atomic<const Type *>> types;
+    Type decodeType(int32_t index, bool voidToInt);
+    uint64_t valueOf(int32_t index, ConstantPoolEntry::tagEnum tag);
+    ShapeCpInfo &getShapeCp(int32_t index);
 
   public:
-    ConstantPoolEntry *getEntry(int index) { return poolEntries[index].get(); }
-    std::string getStringCp(int32_t index);
+    ConstantPoolEntry::tagEnum getTag(int32_t index) { return ConstantPoolEntry::tagEnum(tags[index]); }
+    std::string_view getStringCp(int32_t index);
     int64_t getIntCp(int32_t index);
-    Type getTypeCp(int32_t index, bool voidToInt);
+    const Type &getTypeCp(int32_t index, bool voidToInt);
     double getFloatCp(int32_t index);
     bool getBooleanCp(int32_t index);
+    PackageCpInfo getPackageCp(int32_t index);
     TypeTag getTypeTag(int32_t index);
     InvocableType getInvocableType(int32_t index);
 };
 
 class TypeIdSet {
   public:
-    void read(Parser &reader);
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t pkgIdCpIndex;
@@ -233,7 +188,8 @@ class TypeIdSet {
 };
 class TypeId {
   public:
-    void read(Parser &reader);
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t primaryTypeIdCount;
@@ -250,12 +206,14 @@ class TypeId {
 
 class Markdown {
   public:
-    static void read(Parser &reader);
+    template <typename ParserT>
+    static void read(ParserT &reader);
 };
 
 class ObjectField {
   public:
-    void read(Parser &reader);
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t nameCpIndex;
@@ -273,7 +231,8 @@ class ObjectField {
 // identical for RecordInitFunction
 class ObjectAttachedFunction {
   public:
-    void read(Parser &reader);
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t nameCpIndex;
@@ -288,7 +247,8 @@ class ObjectAttachedFunction {
 
 class TableFieldNameList {
   public:
-    void read(Parser &reader);
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t size;
@@ -297,7 +257,8 @@ class TableFieldNameList {
 
 class RecordField {
   public:
-    void read(Parser &reader);
+    template <typename ParserT>
+    void read(ParserT &reader);
 
   private:
     int32_t nameCpIndex;
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __FUNCTIONIGNORELIST__H__
+#define __FUNCTIONIGNORELIST__H__
+
+#include <cstddef>
+#include <llvm/ADT/StringSet.h>
+#include <set>
+#include <string_view>
+#include <vector>
+
+namespace nballerina {
+
+// Set of function name prefixes that are skipped by the reader. A lookup only
+// probes the prefix lengths that are actually in the set.
+class FunctionIgnoreList {
+  private:
+    llvm::StringSet<> prefixes;
+    std::set<size_t> prefixLengths;
+
+  public:
+    // Starts with the module init/start/stop functions, which are not compiled
+    FunctionIgnoreList();
+
+    void addPrefix(std::string_view prefix);
+    void clear();
+    bool isIgnored(std::string_view functionName) const;
+    // The prefixes in sorted order
+    std::vector<std::string_view> getPrefixes() const;
+};
+
+} // namespace nballerina
+
+#endif //!__FUNCTIONIGNORELIST__H__
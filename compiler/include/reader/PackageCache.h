@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __PACKAGECACHE__H__
+#define __PACKAGECACHE__H__
+
+#include "bir/Package.h"
+#include "interfaces/NonTerminatorInsn.h"
+#include "interfaces/TerminatorInsn.h"
+#include "reader/ReaderOptions.h"
+#include <llvm/ADT/StringRef.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace nballerina {
+
+class PackageCacheWriter;
+class PackageCacheReader;
+
+// Compact, versioned binary form of a decoded Package, keyed by a hash of the
+// BIR dump it was read from. Loading one skips the constant pool and every
+// section of the dump the reader only walks over, and its strings are used in
+// place from the mapped file.
+//
+// Layout (little endian): magic, format version, key, a checksum of the rest,
+// the string lengths and their bytes, then the package itself, where every
+// string is an index into the strings and every type an index into the type
+// table.
+class PackageCache {
+  private:
+    inline static const std::string MAGIC = "NBPC";
+    PackageCache() = default;
+    static void writePackage(PackageCacheWriter &writer, const Package &package);
+    static void writeFunction(PackageCacheWriter &writer, const Function &function);
+    static void writeInstruction(PackageCacheWriter &writer, const NonTerminatorInsn &insn);
+    static void writeTerminator(PackageCacheWriter &writer, const TerminatorInsn &insn);
+    static bool readPackage(PackageCacheReader &reader, Package &package);
+    static bool readFunction(PackageCacheReader &reader, Package &package);
+    static bool readInstruction(PackageCacheReader &reader, BasicBlock &basicBlock);
+    static bool readTerminator(PackageCacheReader &reader, BasicBlock &basicBlock);
+
+  public:
+    // Bump whenever the layout or the meaning of a field changes
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // Key of the package read from dump with options, the reader options
+    // that decide which functions are kept are part of it
+    static uint64_t getKey(llvm::StringRef dump, const ReaderOptions &options);
+    static std::string getPath(const std::string &directory, uint64_t key);
+    // Returns nullptr if there is no usable entry at path: missing, written
+    // for another key or format version, or damaged
+    static std::shared_ptr<Package> load(const std::string &path, uint64_t key);
+    // Written under a temporary name first, so that readers never see a
+    // partial file
+    static bool store(const Package &package, const std::string &path, uint64_t key);
+};
+
+} // namespace nballerina
+
+#endif //!__PACKAGECACHE__H__
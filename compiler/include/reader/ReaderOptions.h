@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __READEROPTIONS__H__
+#define __READEROPTIONS__H__
+
+#include "reader/FunctionIgnoreList.h"
+#include <string>
+#include <vector>
+
+namespace nballerina {
+
+enum ReaderMode { READER_MODE_STREAM = 0, READER_MODE_MMAP = 1 };
+
+struct ReaderOptions {
+    ReaderMode mode = READER_MODE_MMAP;
+    // Threads used to decode function bodies, 0 uses all hardware threads
+    unsigned jobs = 0;
+    // Functions skipped without decoding their bodies
+    FunctionIgnoreList ignoredFunctions;
+    // Only keep functions reachable through calls from main, public functions
+    // and entryPoints
+    bool reachableOnly = false;
+    std::vector<std::string> entryPoints;
+    // Directory of the compact package cache, see PackageCache. Empty
+    // disables the cache.
+    std::string cacheDirectory;
+};
+
+} // namespace nballerina
+
+#endif //!__READEROPTIONS__H__
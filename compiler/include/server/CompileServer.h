@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __COMPILESERVER__H__
+#define __COMPILESERVER__H__
+
+#include <llvm/ADT/ArrayRef.h>
+#include <functional>
+#include <string>
+
+namespace nballerina {
+
+// Serves compile requests over a Unix domain socket, so that a build running
+// many small compiles does not pay for process start up, dynamic linking and
+// LLVM target initialization on every one of them. Not available on Windows.
+class CompileServer {
+  private:
+    CompileServer() = default;
+
+  public:
+    // Compiles with the given command line, args[0] being the program name,
+    // and returns the exit status
+    using CompileFunction = std::function<int(llvm::ArrayRef<const char *> args)>;
+
+    // Accepts requests on socketPath until the server is killed. Each request
+    // is compiled by compile in a process forked from the server, in the
+    // working directory of the client.
+    static int serve(const std::string &socketPath, const CompileFunction &compile);
+    // Sends args to the server on socketPath, relays its output to stdout and
+    // stderr and returns the exit status of the compile. Returns -1, without
+    // any output, when no server is listening.
+    static int forward(const std::string &socketPath, llvm::ArrayRef<const char *> args);
+};
+
+} // namespace nballerina
+
+#endif //!__COMPILESERVER__H__
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "reader/BIRBufferReader.h"
+#include <iostream>
+
+namespace nballerina {
+
+BIRBufferReader::BIRBufferReader(llvm::StringRef buffer) : cursor(buffer.begin()), bufferEnd(buffer.end()) {}
+
+size_t BIRBufferReader::remaining() const { return bufferEnd - cursor; }
+
+void BIRBufferReader::reportTruncated(std::streamsize length) const {
+    std::cerr << "Unexpected end of BIR data: need " << length << " bytes, " << remaining() << " available"
+              << std::endl;
+    abort();
+}
+
+void BIRBufferReader::reportNegativeLength(std::streamsize length) const {
+    std::cerr << "Malformed BIR: negative length " << length << std::endl;
+    abort();
+}
+
+} // namespace nballerina
@@ -17,98 +17,172 @@
  */
 
 #include "reader/BIRFileReader.h"
+#include "bir/CompilerStats.h"
+#include "reader/BIRBufferReader.h"
+#include "reader/BIRFunctionStream.h"
 #include "reader/BIRReadPackage.h"
+#include "reader/BIRStreamReader.h"
+#include "reader/ByteSource.h"
 #include "reader/ConstantPool.h"
+#include "reader/PackageCache.h"
+#include <chrono>
+#include <iostream>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 namespace nballerina {
 
-BIRFileReader::BIRFileReader(std::string FileName) { is.open(FileName, std::ifstream::binary); }
-
-std::shared_ptr<Package> BIRFileReader::deserialize(const std::string &FileName) {
-    // Open File
-    BIRFileReader reader{FileName};
+template <typename ParserT>
+static void readPackage(Package &birPackage, ConstantPoolSet &cp, ParserT &reader, const ReaderOptions &options,
+                        std::vector<PendingFunctionBody> *deferredBodies = nullptr) {
     // Read Constant Pool
-    ConstantPoolSet cp;
-    cp.read(reader);
+    {
+        PhaseScope phase("Decode constant pool");
+        auto allocatedBefore = birPackage.getAllocatedBytes();
+        cp.read(reader);
+        phase.setAllocatedBytes(birPackage.getAllocatedBytes() - allocatedBefore);
+    }
     // Read Module
-    return BIRReadPackage::readModule(reader, cp);
+    PhaseScope phase("Decode module");
+    auto allocatedBefore = birPackage.getAllocatedBytes();
+    BIRReadPackage<ParserT>::readModule(birPackage, reader, cp, options, deferredBodies);
+    phase.setAllocatedBytes(birPackage.getAllocatedBytes() - allocatedBefore);
 }
 
-static bool isLittleEndian() {
-    unsigned int val = 1;
-    auto *c = reinterpret_cast<char *>(&val);
-    return (int)*c != 0;
+template <typename ParserT>
+static std::shared_ptr<Package> readPackage(ParserT &reader, const ReaderOptions &options) {
+    auto birPackage = std::make_shared<Package>();
+    ConstantPoolSet cp{birPackage->getSymbolTable(), birPackage->getTypeTable()};
+    readPackage(*birPackage, cp, reader, options);
+    return birPackage;
 }
 
-template <typename T>
-T swapEndian(T u) {
-    static_assert(CHAR_BIT == 8);
-    union {
-        T u;
-        unsigned char u8[sizeof(T)];
-    } source, dest;
-
-    source.u = u;
-
-    for (size_t k = 0; k < sizeof(T); k++) {
-        dest.u8[k] = source.u8[sizeof(T) - k - 1];
+static std::unique_ptr<ByteSource> openByteSource(const std::string &FileName) {
+    std::string errorMessage;
+    auto source = ByteSource::open(FileName, errorMessage);
+    if (!source) {
+        std::cerr << "Unable to open BIR file: " << FileName << " (" << errorMessage << ")" << std::endl;
+        abort();
     }
-    return dest.u;
+    return source;
 }
 
-// Read 1 byte from the stream
-uint8_t BIRFileReader::readU1() {
-    uint8_t value = 0;
-    is.read(reinterpret_cast<char *>(&value), sizeof(value));
-    return value;
+// Maps the whole dump, or returns nullptr when it has to be streamed instead:
+// stdin and named pipes cannot be mapped and compressed dumps are decoded on
+// the fly by the stream reader
+static std::unique_ptr<llvm::MemoryBuffer> mapFile(const std::string &FileName, const ReaderOptions &options) {
+    if (options.mode == READER_MODE_STREAM || FileName == "-" || !llvm::sys::fs::is_regular_file(FileName)) {
+        return nullptr;
+    }
+    auto fileOrErr = llvm::MemoryBuffer::getFile(FileName, -1, false);
+    if (!fileOrErr) {
+        std::cerr << "Unable to open BIR file: " << FileName << " (" << fileOrErr.getError().message() << ")"
+                  << std::endl;
+        abort();
+    }
+    if ((*fileOrErr)->getBuffer().startswith(ByteSource::ZSTD_MAGIC)) {
+        return nullptr;
+    }
+    return std::move(*fileOrErr);
 }
 
-// Read 2 bytes from the stream
-int16_t BIRFileReader::readS2be() {
-    int16_t value = 0;
-    char *p = reinterpret_cast<char *>(&value);
-    is.read(p, sizeof(value));
-    if (!isLittleEndian()) {
-        return value;
+// Loads the package from the package cache, or decodes the dump and adds it
+// to the cache. The key hashes the raw file, so a compressed dump is keyed by
+// its compressed bytes.
+static std::shared_ptr<Package> deserializeCached(const std::string &FileName, const ReaderOptions &options) {
+    auto fileOrErr = llvm::MemoryBuffer::getFile(FileName, -1, false);
+    if (!fileOrErr) {
+        std::cerr << "Unable to open BIR file: " << FileName << " (" << fileOrErr.getError().message() << ")"
+                  << std::endl;
+        abort();
+    }
+    auto rawFile = std::move(*fileOrErr);
+    uint64_t key = 0;
+    {
+        PhaseScope phase("Hash BIR");
+        key = PackageCache::getKey(rawFile->getBuffer(), options);
+    }
+    auto cachePath = PackageCache::getPath(options.cacheDirectory, key);
+    {
+        PhaseScope phase("Load package cache");
+        if (auto birPackage = PackageCache::load(cachePath, key)) {
+            phase.setAllocatedBytes(birPackage->getAllocatedBytes());
+            return birPackage;
+        }
     }
-    return swapEndian<int16_t>(value);
-}
 
-// Read 4 bytes from the stream
-int32_t BIRFileReader::readS4be() {
-    int32_t value = 0;
-    char *p = reinterpret_cast<char *>(&value);
-    is.read(p, sizeof(value));
-    if (!isLittleEndian()) {
-        return value;
+    std::shared_ptr<Package> birPackage;
+    if (options.mode == READER_MODE_STREAM || rawFile->getBuffer().startswith(ByteSource::ZSTD_MAGIC)) {
+        BIRStreamReader reader{openByteSource(FileName)};
+        birPackage = readPackage(reader, options);
+    } else {
+        BIRBufferReader reader{rawFile->getBuffer()};
+        birPackage = readPackage(reader, options);
     }
-    return swapEndian<int32_t>(value);
+    PhaseScope phase("Write package cache");
+    if (!PackageCache::store(*birPackage, cachePath, key)) {
+        std::cerr << "Warning: unable to write package cache entry " << cachePath << std::endl;
+    }
+    return birPackage;
 }
 
-// Read 8 bytes from the stream
-int64_t BIRFileReader::readS8be() {
-    int64_t value = 0;
-    char *p = reinterpret_cast<char *>(&value);
-    is.read(p, sizeof(value));
-    if (!isLittleEndian()) {
-        return value;
+std::shared_ptr<Package> BIRFileReader::deserialize(const std::string &FileName, const ReaderOptions &options) {
+    PhaseScope phase("Read BIR");
+    std::shared_ptr<Package> birPackage;
+    if (!options.cacheDirectory.empty() && FileName != "-" && llvm::sys::fs::is_regular_file(FileName)) {
+        birPackage = deserializeCached(FileName, options);
+    } else if (auto mappedFile = mapFile(FileName, options)) {
+        // The mapped buffer must stay alive until decoding is done
+        BIRBufferReader reader{mappedFile->getBuffer()};
+        birPackage = readPackage(reader, options);
+    } else {
+        BIRStreamReader reader{openByteSource(FileName)};
+        birPackage = readPackage(reader, options);
     }
-    return swapEndian<int64_t>(value);
+    phase.setAllocatedBytes(birPackage->getAllocatedBytes());
+    return birPackage;
 }
 
-// Read 8 bytes from the stream for float value
-double BIRFileReader::readS8bef() {
-    double value = NAN;
-    char *p = reinterpret_cast<char *>(&value);
-    is.read(p, sizeof(value));
-    if (!isLittleEndian()) {
-        return value;
+std::unique_ptr<BIRFunctionStream> BIRFileReader::openFunctionStream(const std::string &FileName,
+                                                                     const ReaderOptions &options, size_t lookahead) {
+    std::unique_ptr<BIRFunctionStream> stream(new BIRFunctionStream(lookahead));
+    stream->package = std::make_shared<Package>();
+    stream->cp = std::make_unique<ConstantPoolSet>(stream->package->getSymbolTable(),
+                                                   stream->package->getTypeTable());
+    {
+        PhaseScope phase("Read function table");
+        // The stream owns the mapped buffer or stream reader, which the
+        // undecoded bodies point into
+        stream->mappedFile = mapFile(FileName, options);
+        if (!stream->mappedFile) {
+            stream->streamReader = std::make_unique<BIRStreamReader>(openByteSource(FileName));
+            readPackage(*stream->package, *stream->cp, *stream->streamReader, options, &stream->pendingBodies);
+        } else {
+            BIRBufferReader reader{stream->mappedFile->getBuffer()};
+            readPackage(*stream->package, *stream->cp, reader, options, &stream->pendingBodies);
+        }
+        phase.setAllocatedBytes(stream->package->getAllocatedBytes());
     }
-    return swapEndian<double>(value);
+    stream->start();
+    return stream;
 }
 
-void BIRFileReader::ignore(std::streamsize length) { is.ignore(length); }
-
-void BIRFileReader::readChars(char *outBuff, std::streamsize length) { is.read(outBuff, length); }
+double BIRFileReader::measureThroughput(const std::string &FileName, const ReaderOptions &options,
+                                        unsigned iterations) {
+    uint64_t fileSize = 0;
+    if (llvm::sys::fs::file_size(FileName, fileSize) || iterations == 0) {
+        return 0;
+    }
+    // Time the readers themselves, a package cache hit would skip them
+    auto readerOptions = options;
+    readerOptions.cacheDirectory.clear();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; i++) {
+        [[maybe_unused]] auto package = deserialize(FileName, readerOptions);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double totalMB = static_cast<double>(fileSize) * iterations / (1024 * 1024);
+    return totalMB / elapsed.count();
+}
 
 } // namespace nballerina
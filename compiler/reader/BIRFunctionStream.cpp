@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "reader/BIRFunctionStream.h"
+#include "bir/CompilerStats.h"
+#include <algorithm>
+
+namespace nballerina {
+
+BIRFunctionStream::BIRFunctionStream(size_t lookahead) : lookahead(std::max<size_t>(1, lookahead)) {}
+
+BIRFunctionStream::~BIRFunctionStream() {
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        stopping = true;
+    }
+    functionTaken.notify_one();
+    if (readerThread.joinable()) {
+        readerThread.join();
+    }
+}
+
+Package &BIRFunctionStream::getPackage() { return *package; }
+
+void BIRFunctionStream::start() { readerThread = std::thread(&BIRFunctionStream::decodeBodies, this); }
+
+// The function table is complete before the thread starts, so the Function
+// slots handed out never move
+void BIRFunctionStream::decodeBodies() {
+    TraceThreadScope traceThread;
+    {
+        // Recorded before the stream reports that it is finished, so that
+        // --stats printed after the last function includes it
+        PhaseScope phase("Decode function bodies");
+        // Counted per function before it is handed over, codegen frees it
+        // later. Only this thread interns names while the stream is open.
+        size_t allocatedBytes = 0;
+        auto symbolBytesBefore = package->getSymbolTable().getBytesAllocated();
+        for (auto &body : pendingBodies) {
+            {
+                std::unique_lock<std::mutex> lock(queueLock);
+                functionTaken.wait(lock, [this] { return decodedFunctions.size() < lookahead || stopping; });
+                if (stopping) {
+                    return;
+                }
+            }
+            auto &function = package->functions[body.functionIndex];
+            BIRReadFunctionBody::readFunctionBody(function, body, *cp);
+            allocatedBytes += function.getArena().getBytesAllocated();
+            {
+                std::lock_guard<std::mutex> lock(queueLock);
+                decodedFunctions.push_back(&function);
+            }
+            functionDecoded.notify_one();
+        }
+        phase.setAllocatedBytes(allocatedBytes + package->getSymbolTable().getBytesAllocated() - symbolBytesBefore);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        finished = true;
+    }
+    functionDecoded.notify_one();
+}
+
+Function *BIRFunctionStream::readNextFunction() {
+    std::unique_lock<std::mutex> lock(queueLock);
+    functionDecoded.wait(lock, [this] { return !decodedFunctions.empty() || finished; });
+    if (decodedFunctions.empty()) {
+        return nullptr;
+    }
+    auto *function = decodedFunctions.front();
+    decodedFunctions.pop_front();
+    lock.unlock();
+    functionTaken.notify_one();
+    return function;
+}
+
+} // namespace nballerina
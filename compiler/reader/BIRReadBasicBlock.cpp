@@ -17,23 +17,30 @@
  */
 
 #include "reader/BIRReadBasicBlock.h"
+#include "reader/BIRBufferReader.h"
 #include "reader/BIRReadInsns.h"
+#include "reader/BIRStreamReader.h"
 
 namespace nballerina {
 
-void BIRReadBasicBlock::readBasicBlock(Function &birFunction, Parser &reader, ConstantPoolSet &cp, bool ignore) {
+template <typename ParserT>
+void BIRReadBasicBlock<ParserT>::readBasicBlock(Function &birFunction, ParserT &reader, ConstantPoolSet &cp,
+                                                bool ignore) {
     int32_t nameCpIndex = reader.readS4be();
-    birFunction.basicBlocks.emplace_back(cp.getStringCp(nameCpIndex), &birFunction);
-    auto &basicBlock = birFunction.basicBlocks.back();
+    auto &basicBlock = *birFunction.arena.create<BasicBlock>(cp.getStringCp(nameCpIndex), &birFunction);
 
     int32_t insnCount = reader.readS4be();
     basicBlock.instructions.reserve(insnCount);
     for (auto i = 0; i < insnCount; i++) {
-        BIRReadInsn::readInsn(basicBlock, reader, cp);
+        BIRReadInsn<ParserT>::readInsn(basicBlock, reader, cp);
     }
-    if (ignore) {
-        birFunction.basicBlocks.pop_back();
+    // Ignored blocks stay in the arena but are not part of the function
+    if (!ignore) {
+        birFunction.basicBlocks.push_back(&basicBlock);
     }
 }
 
+template class BIRReadBasicBlock<BIRStreamReader>;
+template class BIRReadBasicBlock<BIRBufferReader>;
+
 } // namespace nballerina
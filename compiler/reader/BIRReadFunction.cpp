@@ -17,30 +17,23 @@
  */
 
 #include "reader/BIRReadFunction.h"
+#include "bir/CompilerStats.h"
+#include "bir/ConditionBrInsn.h"
 #include "bir/Package.h"
+#include "reader/BIRBufferReader.h"
 #include "reader/BIRReadBasicBlock.h"
-#include <queue>
-#include <string>
+#include "reader/BIRStreamReader.h"
+#include <llvm/Support/ThreadPool.h>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace nballerina {
 
-static bool ignoreFunction(const std::string &funcName) {
-    const std::vector<std::string> ignoreNames{".<init>", ".<start>", ".<stop>", "..<init>", "..<start>", "..<stop>"};
-    bool ignoreFunction = false;
-    for (const auto &name : ignoreNames) {
-        if (funcName.rfind(name, 0) == 0) {
-            ignoreFunction = true;
-            break;
-        }
-    }
-    return ignoreFunction;
-}
-
-void BIRReadFunction::readLocalVar(Function &function, Parser &reader, ConstantPoolSet &cp) {
+void BIRReadFunctionBody::readLocalVar(Function &function, BIRBufferReader &reader, ConstantPoolSet &cp) {
     uint8_t kind = reader.readU1();
     int32_t typeCpIndex = reader.readS4be();
-    auto type = cp.getTypeCp(typeCpIndex, false);
+    const auto &type = cp.getTypeCp(typeCpIndex, false);
     int32_t nameCpIndex = reader.readS4be();
 
     if (kind == ARG_VAR_KIND) {
@@ -52,10 +45,175 @@ void BIRReadFunction::readLocalVar(Function &function, Parser &reader, ConstantP
         [[maybe_unused]] int32_t startBbIdCpIndex = reader.readS4be();
         [[maybe_unused]] int32_t instructionOffset = reader.readS4be();
     }
-    function.localVars.emplace_back(std::move(type), cp.getStringCp(nameCpIndex), (VarKind)kind);
+    auto name = cp.getStringCp(nameCpIndex);
+    function.localVarIndices.emplace(name, function.localVars.size());
+    function.localVars.emplace_back(type, name, (VarKind)kind);
+}
+
+// Branches can jump forward, so targets are resolved once all blocks are read
+void BIRReadFunctionBody::resolveBranchTargets(Function &birFunction) {
+    std::unordered_map<std::string_view, uint32_t> blockIndices;
+    blockIndices.reserve(birFunction.basicBlocks.size());
+    for (size_t i = 0; i < birFunction.basicBlocks.size(); i++) {
+        blockIndices.emplace(birFunction.basicBlocks[i]->getId(), i);
+    }
+    auto indexOf = [&blockIndices](std::string_view id) -> uint32_t {
+        auto result = blockIndices.find(id);
+        return (result == blockIndices.end()) ? INVALID_BB_INDEX : result->second;
+    };
+    for (auto *basicBlock : birFunction.basicBlocks) {
+        auto *terminator = basicBlock->getTerminatorInsnPtr();
+        if (terminator == nullptr) {
+            continue;
+        }
+        terminator->setThenBBIndex(indexOf(terminator->getThenBBID()));
+        if (terminator->getKind() == INSTRUCTION_KIND_CONDITIONAL_BRANCH) {
+            auto *condBr = static_cast<ConditionBrInsn *>(terminator);
+            condBr->setElseBBIndex(indexOf(condBr->getElseBBID()));
+        }
+    }
+}
+
+void BIRReadFunctionBody::readFunctionBody(Function &birFunction, PendingFunctionBody &pending, ConstantPoolSet &cp) {
+    llvm::TimeTraceScope traceScope("Decode function",
+                                    llvm::StringRef(birFunction.name.data(), birFunction.name.size()));
+    BIRBufferReader reader{pending.body};
+
+    [[maybe_unused]] int32_t argsCount = reader.readS4be();
+    uint8_t hasReturnVar = reader.readU1();
+
+    // returnVar
+    if (hasReturnVar != 0U) {
+        uint8_t kind = reader.readU1();
+        int32_t typeCpIndex = reader.readS4be();
+        const auto &type = cp.getTypeCp(typeCpIndex, false);
+        int32_t nameCpIndex = reader.readS4be();
+        birFunction.returnVar = Variable(type, cp.getStringCp(nameCpIndex), (VarKind)kind);
+    }
+
+    int32_t paramsWithDefaults = reader.readS4be();
+    birFunction.requiredParams.reserve(paramsWithDefaults);
+    for (auto i = 0; i < paramsWithDefaults; i++) {
+        uint8_t kind = reader.readU1();
+        int32_t typeCpIndex = reader.readS4be();
+        birFunction.requiredParams.emplace_back(std::move(pending.params[i]), cp.getTypeCp(typeCpIndex, false));
+        [[maybe_unused]] int32_t nameCpIndex = reader.readS4be();
+        if (kind == ARG_VAR_KIND) {
+            [[maybe_unused]] int32_t metaVarNameCpIndex = reader.readS4be();
+        }
+        [[maybe_unused]] uint8_t hasDefaultExpr = reader.readU1();
+    }
+
+    int32_t localVarCount = reader.readS4be();
+    birFunction.localVars.reserve(localVarCount);
+    birFunction.localVarIndices.reserve(localVarCount);
+    for (auto i = 0; i < localVarCount; i++) {
+        readLocalVar(birFunction, reader, cp);
+    }
+
+    for (auto i = 0; i < paramsWithDefaults; i++) {
+        // default parameter basic blocks info
+        int32_t defaultParameterBBCount = reader.readS4be();
+        for (auto i = 0; i < defaultParameterBBCount; i++) {
+            BIRReadBasicBlock<BIRBufferReader>::readBasicBlock(birFunction, reader, cp, true);
+        }
+    }
+
+    // basic block info
+    int32_t BBCount = reader.readS4be();
+    birFunction.basicBlocks.reserve(BBCount);
+    for (auto i = 0; i < BBCount; i++) {
+        BIRReadBasicBlock<BIRBufferReader>::readBasicBlock(birFunction, reader, cp);
+    }
+    resolveBranchTargets(birFunction);
+
+    // error table
+    [[maybe_unused]] int32_t errorEntriesCount = reader.readS4be();
+    [[maybe_unused]] int32_t channelsLength = reader.readS4be();
 }
 
-void BIRReadFunction::readFunction(Package &package, Parser &reader, ConstantPoolSet &cp, bool ignore) {
+void BIRReadFunctionBody::readFunctionBodies(Package &package, std::vector<PendingFunctionBody> &pending,
+                                             ConstantPoolSet &cp, unsigned jobs) {
+    PhaseScope phase("Decode function bodies");
+    auto allocatedBefore = package.getAllocatedBytes();
+    if (jobs == 1 || pending.size() < 2) {
+        for (auto &body : pending) {
+            readFunctionBody(package.functions[body.functionIndex], body, cp);
+        }
+        phase.setAllocatedBytes(package.getAllocatedBytes() - allocatedBefore);
+        return;
+    }
+    // Every body writes only to its own, already allocated, Function slot
+    llvm::ThreadPool pool(llvm::hardware_concurrency(jobs));
+    for (auto &body : pending) {
+        pool.async([&package, &body, &cp] {
+            TraceThreadScope traceThread;
+            readFunctionBody(package.functions[body.functionIndex], body, cp);
+        });
+    }
+    pool.wait();
+    phase.setAllocatedBytes(package.getAllocatedBytes() - allocatedBefore);
+}
+
+void BIRReadFunctionBody::readReachableFunctionBodies(Package &package, std::vector<PendingFunctionBody> &pending,
+                                                      ConstantPoolSet &cp, const std::vector<std::string> &entryPoints,
+                                                      unsigned jobs) {
+    std::unordered_map<std::string_view, size_t> pendingByName;
+    for (size_t i = 0; i < pending.size(); i++) {
+        pendingByName.emplace(package.functions[pending[i].functionIndex].getName(), i);
+    }
+    std::vector<bool> reached(package.functions.size(), false);
+    std::vector<PendingFunctionBody> wave;
+    auto reach = [&](std::string_view name) {
+        auto it = pendingByName.find(name);
+        if (it == pendingByName.end()) {
+            return;
+        }
+        auto &body = pending[it->second];
+        if (!reached[body.functionIndex]) {
+            reached[body.functionIndex] = true;
+            wave.push_back(std::move(body));
+        }
+    };
+
+    for (const auto &function : package.functions) {
+        if (function.isMainFunction() || function.isPublicFunction()) {
+            reach(function.getName());
+        }
+    }
+    for (const auto &name : entryPoints) {
+        reach(name);
+    }
+
+    // Each wave decodes the bodies found by the previous one, in parallel
+    while (!wave.empty()) {
+        std::vector<PendingFunctionBody> decoded = std::move(wave);
+        wave.clear();
+        readFunctionBodies(package, decoded, cp, jobs);
+        for (const auto &body : decoded) {
+            for (auto calleeName : package.functions[body.functionIndex].getCalleeNames()) {
+                reach(calleeName);
+            }
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < package.functions.size(); i++) {
+        if (!reached[i]) {
+            continue;
+        }
+        if (kept != i) {
+            package.functions[kept] = std::move(package.functions[i]);
+        }
+        kept++;
+    }
+    package.functions.erase(package.functions.begin() + kept, package.functions.end());
+}
+
+template <typename ParserT>
+void BIRReadFunction<ParserT>::readFunction(Package &package, ParserT &reader, ConstantPoolSet &cp,
+                                            std::vector<PendingFunctionBody> &pendingBodies,
+                                            const FunctionIgnoreList &ignoreList, bool ignore) {
 
     // Read debug info
     // position
@@ -70,16 +228,19 @@ void BIRReadFunction::readFunction(Package &package, Parser &reader, ConstantPoo
     package.sourceFileName = cp.getStringCp(sourceFileCpIndex);
 
     int32_t nameCpIndex = reader.readS4be();
-    std::string functionName = cp.getStringCp(nameCpIndex);
+    auto functionName = cp.getStringCp(nameCpIndex);
     int32_t workdernameCpIndex = reader.readS4be();
     int32_t flags = reader.readS8be();
     [[maybe_unused]] uint8_t origin = reader.readU1();
     int32_t typeCpIndex = reader.readS4be();
-    [[maybe_unused]] auto invocable_type = cp.getInvocableType(typeCpIndex);
 
-    package.functions.emplace_back(&package, functionName, cp.getStringCp(workdernameCpIndex), flags);
-    auto &birFunction = package.functions.back();
-    birFunction.setLocation(location);
+    // Skipped functions only need their header walked, nothing is materialized
+    bool skip = ignore || ignoreList.isIgnored(functionName);
+    if (!skip) {
+        package.functions.emplace_back(&package, functionName, cp.getStringCp(workdernameCpIndex), flags);
+        package.functions.back().setLocation(location);
+        package.functions.back().signature = cp.getInvocableType(typeCpIndex);
+    }
 
     // annotation_attachments_content
     int64_t annotationLength = reader.readS8be(); // annotation_attachments_content_length
@@ -88,10 +249,16 @@ void BIRReadFunction::readFunction(Package &package, Parser &reader, ConstantPoo
     int32_t requiredParamCount = reader.readS4be();
 
     // Set function param here and then fill remaining values from the default Params
-    std::queue<Operand> functionParams;
+    PendingFunctionBody pending;
+    pending.functionIndex = package.functions.size() - 1;
+    if (!skip) {
+        pending.params.reserve(requiredParamCount);
+    }
     for (auto i = 0; i < requiredParamCount; i++) {
         int32_t paramNameCpIndex = reader.readS4be();
-        functionParams.emplace(Operand(cp.getStringCp(paramNameCpIndex), ARG_VAR_KIND));
+        if (!skip) {
+            pending.params.emplace_back(cp.getStringCp(paramNameCpIndex), ARG_VAR_KIND);
+        }
         [[maybe_unused]] int64_t paramFlags = reader.readS8be();
     }
 
@@ -115,9 +282,7 @@ void BIRReadFunction::readFunction(Package &package, Parser &reader, ConstantPoo
     reader.ignore(docLength);
 
     int32_t depended_global_var_length = reader.readS4be();
-    for (auto i = 0; i < depended_global_var_length; i++) {
-        [[maybe_unused]] int32_t depended_global_var_cp_entry = reader.readS4be();
-    }
+    reader.ignore(depended_global_var_length * sizeof(int32_t));
     [[maybe_unused]] int64_t scopeTableLength = reader.readS8be();
     int32_t scopeEntryCount = reader.readS4be();
     // scope entry
@@ -130,61 +295,17 @@ void BIRReadFunction::readFunction(Package &package, Parser &reader, ConstantPoo
         }
     }
 
-    [[maybe_unused]] int64_t functionBodyLength = reader.readS8be();
-    // function body
-    [[maybe_unused]] int32_t argsCount = reader.readS4be();
-    uint8_t hasReturnVar = reader.readU1();
-
-    // returnVar
-    if (hasReturnVar != 0U) {
-        uint8_t kind = reader.readU1();
-        int32_t typeCpIndex = reader.readS4be();
-        auto type = cp.getTypeCp(typeCpIndex, false);
-        int32_t nameCpIndex = reader.readS4be();
-        birFunction.returnVar = Variable(std::move(type), cp.getStringCp(nameCpIndex), (VarKind)kind);
-    }
-
-    int32_t paramsWithDefaults = reader.readS4be();
-    birFunction.requiredParams.reserve(paramsWithDefaults);
-    for (auto i = 0; i < paramsWithDefaults; i++) {
-        uint8_t kind = reader.readU1();
-        int32_t typeCpIndex = reader.readS4be();
-        birFunction.requiredParams.emplace_back(std::move(functionParams.front()), cp.getTypeCp(typeCpIndex, false));
-        functionParams.pop();
-        [[maybe_unused]] int32_t nameCpIndex = reader.readS4be();
-        if (kind == ARG_VAR_KIND) {
-            [[maybe_unused]] int32_t metaVarNameCpIndex = reader.readS4be();
-        }
-        [[maybe_unused]] uint8_t hasDefaultExpr = reader.readU1();
-    }
-
-    int32_t localVarCount = reader.readS4be();
-    birFunction.localVars.reserve(localVarCount);
-    for (auto i = 0; i < localVarCount; i++) {
-        readLocalVar(birFunction, reader, cp);
-    }
-
-    for (auto i = 0; i < paramsWithDefaults; i++) {
-        // default parameter basic blocks info
-        int32_t defaultParameterBBCount = reader.readS4be();
-        for (auto i = 0; i < defaultParameterBBCount; i++) {
-            BIRReadBasicBlock::readBasicBlock(birFunction, reader, cp, true);
-        }
-    }
-
-    // basic block info
-    int32_t BBCount = reader.readS4be();
-    birFunction.basicBlocks.reserve(BBCount);
-    for (auto i = 0; i < BBCount; i++) {
-        BIRReadBasicBlock::readBasicBlock(birFunction, reader, cp);
+    // function body, decoded later from its own buffer
+    int64_t functionBodyLength = reader.readS8be();
+    if (skip) {
+        reader.ignore(functionBodyLength);
+        return;
     }
+    pending.body = reader.readBlob(functionBodyLength);
+    pendingBodies.push_back(std::move(pending));
+}
 
-    // error table
-    [[maybe_unused]] int32_t errorEntriesCount = reader.readS4be();
-    [[maybe_unused]] int32_t channelsLength = reader.readS4be();
+template class BIRReadFunction<BIRStreamReader>;
+template class BIRReadFunction<BIRBufferReader>;
 
-    if (ignore || ignoreFunction(functionName)) {
-        package.functions.pop_back();
-    }
-}
 } // namespace nballerina
@@ -21,6 +21,7 @@
 #include "bir/BinaryOpInsn.h"
 #include "bir/ConditionBrInsn.h"
 #include "bir/ConstantLoad.h"
+#include "bir/Function.h"
 #include "bir/FunctionCallInsn.h"
 #include "bir/FunctionParam.h"
 #include "bir/GoToInsn.h"
@@ -33,12 +34,16 @@
 #include "bir/TypeDescInsn.h"
 #include "bir/TypeTestInsn.h"
 #include "bir/UnaryOpInsn.h"
+#include "reader/BIRBufferReader.h"
+#include "reader/BIRStreamReader.h"
 #include <iostream>
 
 namespace nballerina {
 
-// Read Local Variable and return Variable pointer
-static Operand readOperand(Parser &reader, ConstantPoolSet &cp) {
+// Read Local Variable and return Variable pointer, resolved against the
+// locals of the enclosing function or the package globals
+template <typename ParserT>
+static Operand readOperand(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     [[maybe_unused]] uint8_t ignoredVar = reader.readU1();
 
     uint8_t kind = reader.readU1();
@@ -50,13 +55,15 @@ static Operand readOperand(Parser &reader, ConstantPoolSet &cp) {
     if ((VarKind)kind == GLOBAL_VAR_KIND) {
         [[maybe_unused]] int32_t packageIndex = reader.readS4be();
         int32_t typeCpIndex = reader.readS4be();
-        [[maybe_unused]] Type typeDecl = cp.getTypeCp(typeCpIndex, false);
+        [[maybe_unused]] const Type &typeDecl = cp.getTypeCp(typeCpIndex, false);
     }
 
-    return Operand(cp.getStringCp(varDclNameCpIndex), (VarKind)kind);
+    auto name = cp.getStringCp(varDclNameCpIndex);
+    return Operand(name, (VarKind)kind, currentBB.getParentFunctionRef().getVariableIndex(name, (VarKind)kind));
 }
 
-void BIRReadInsn::readInsn(BasicBlock &basicBlock, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::readInsn(BasicBlock &basicBlock, ParserT &reader, ConstantPoolSet &cp) {
     int32_t sourceFileCpIndex = reader.readS4be();
     int32_t sLine = reader.readS4be();
     int32_t sCol = reader.readS4be();
@@ -153,49 +160,53 @@ void BIRReadInsn::readInsn(BasicBlock &basicBlock, Parser &reader, ConstantPoolS
 }
 
 // Read Mapping Constructor Key Value body
-static MapConstruct readMapConstructor(Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+static MapConstruct readMapConstructor(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
 
     auto kind = reader.readU1();
     if ((MapConstrctBodyKind)kind == Spread_Field_Kind) {
-        auto expr = readOperand(reader, cp);
+        auto expr = readOperand(currentBB, reader, cp);
         return MapConstruct(MapConstruct::SpreadField(std::move(expr)));
     }
     // For Key_Value_Kind
-    auto key = readOperand(reader, cp);
-    auto value = readOperand(reader, cp);
+    auto key = readOperand(currentBB, reader, cp);
+    auto value = readOperand(currentBB, reader, cp);
     return MapConstruct(MapConstruct::KeyValue(std::move(key), std::move(value)));
 }
 
 // Read TYPEDESC Insn
-void BIRReadInsn::ReadTypeDescInsn(BasicBlock &, Parser &reader, ConstantPoolSet &cp) {
-    [[maybe_unused]] auto lhsOp = readOperand(reader, cp);
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadTypeDescInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    [[maybe_unused]] auto lhsOp = readOperand(currentBB, reader, cp);
     [[maybe_unused]] int32_t typeCpIndex = reader.readS4be();
 }
 
 // Read STRUCTURE Insn
-void BIRReadInsn::ReadStructureInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
-    auto rhsOp = readOperand(reader, cp);
-    [[maybe_unused]] auto lhsOp = readOperand(reader, cp);
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadStructureInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    auto rhsOp = readOperand(currentBB, reader, cp);
+    [[maybe_unused]] auto lhsOp = readOperand(currentBB, reader, cp);
 
     auto initValuesCount = reader.readS4be();
 
     if (initValuesCount == 0) {
-        currentBB.addNonTermInsn(std::make_unique<StructureInsn>(std::move(lhsOp), currentBB));
+        currentBB.addNonTermInsn(currentBB.createInsn<StructureInsn>(std::move(lhsOp), currentBB));
         return;
     }
 
     std::vector<MapConstruct> initValues;
     initValues.reserve(initValuesCount);
     for (auto i = 0; i < initValuesCount; i++) {
-        initValues.push_back(readMapConstructor(reader, cp));
+        initValues.push_back(readMapConstructor(currentBB, reader, cp));
     }
-    currentBB.addNonTermInsn(std::make_unique<StructureInsn>(std::move(lhsOp), currentBB, std::move(initValues)));
+    currentBB.addNonTermInsn(currentBB.createInsn<StructureInsn>(std::move(lhsOp), currentBB, std::move(initValues)));
 }
 
 // Read CONST_LOAD Insn
-void BIRReadInsn::ReadConstLoadInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadConstLoadInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     [[maybe_unused]] int32_t typeCpIndex = reader.readS4be();
-    auto lhsOp = readOperand(reader, cp);
+    auto lhsOp = readOperand(currentBB, reader, cp);
 
     switch (cp.getTypeTag(typeCpIndex)) {
     case TYPE_TAG_INT:
@@ -209,33 +220,33 @@ void BIRReadInsn::ReadConstLoadInsn(BasicBlock &currentBB, Parser &reader, Const
     case TYPE_TAG_BYTE: {
         int32_t valueCpIndex = reader.readS4be();
         currentBB.addNonTermInsn(
-            std::make_unique<ConstantLoadInsn>(std::move(lhsOp), currentBB, (int64_t)cp.getIntCp(valueCpIndex)));
+            currentBB.createInsn<ConstantLoadInsn>(std::move(lhsOp), currentBB, (int64_t)cp.getIntCp(valueCpIndex)));
         return;
     }
     case TYPE_TAG_BOOLEAN: {
         uint8_t boolean_constant = reader.readU1();
         if (boolean_constant == 0) {
-            currentBB.addNonTermInsn(std::make_unique<ConstantLoadInsn>(std::move(lhsOp), currentBB, false));
+            currentBB.addNonTermInsn(currentBB.createInsn<ConstantLoadInsn>(std::move(lhsOp), currentBB, false));
             return;
         }
-        currentBB.addNonTermInsn(std::make_unique<ConstantLoadInsn>(std::move(lhsOp), currentBB, true));
+        currentBB.addNonTermInsn(currentBB.createInsn<ConstantLoadInsn>(std::move(lhsOp), currentBB, true));
         return;
     }
     case TYPE_TAG_FLOAT: {
         int32_t valueCpIndex = reader.readS4be();
         currentBB.addNonTermInsn(
-            std::make_unique<ConstantLoadInsn>(std::move(lhsOp), currentBB, cp.getFloatCp(valueCpIndex)));
+            currentBB.createInsn<ConstantLoadInsn>(std::move(lhsOp), currentBB, cp.getFloatCp(valueCpIndex)));
         return;
     }
     case TYPE_TAG_CHAR_STRING:
     case TYPE_TAG_STRING: {
         int32_t valueCpIndex = reader.readS4be();
         currentBB.addNonTermInsn(
-            std::make_unique<ConstantLoadInsn>(std::move(lhsOp), currentBB, cp.getStringCp(valueCpIndex)));
+            currentBB.createInsn<ConstantLoadInsn>(std::move(lhsOp), currentBB, cp.getStringCp(valueCpIndex)));
         return;
     }
     case TYPE_TAG_NIL: {
-        currentBB.addNonTermInsn(std::make_unique<ConstantLoadInsn>(std::move(lhsOp), currentBB));
+        currentBB.addNonTermInsn(currentBB.createInsn<ConstantLoadInsn>(std::move(lhsOp), currentBB));
         return;
     }
     default: {
@@ -246,145 +257,164 @@ void BIRReadInsn::ReadConstLoadInsn(BasicBlock &currentBB, Parser &reader, Const
 }
 
 // Read Unary Operand
-void BIRReadInsn::ReadUnaryInsn(BasicBlock &currentBB, InstructionKind kind, Parser &reader, ConstantPoolSet &cp) {
-    auto rhsOp = readOperand(reader, cp);
-    auto lhsOp = readOperand(reader, cp);
-    currentBB.addNonTermInsn(std::make_unique<UnaryOpInsn>(std::move(lhsOp), currentBB, std::move(rhsOp), kind));
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadUnaryInsn(BasicBlock &currentBB, InstructionKind kind, ParserT &reader,
+                                         ConstantPoolSet &cp) {
+    auto rhsOp = readOperand(currentBB, reader, cp);
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    currentBB.addNonTermInsn(currentBB.createInsn<UnaryOpInsn>(std::move(lhsOp), currentBB, std::move(rhsOp), kind));
 }
 
 // Read Binary Operand
-void BIRReadInsn::ReadBinaryInsn(BasicBlock &currentBB, InstructionKind kind, Parser &reader, ConstantPoolSet &cp) {
-    auto rhsOp1 = readOperand(reader, cp);
-    auto rhsOp2 = readOperand(reader, cp);
-    auto lhsOp = readOperand(reader, cp);
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadBinaryInsn(BasicBlock &currentBB, InstructionKind kind, ParserT &reader,
+                                          ConstantPoolSet &cp) {
+    auto rhsOp1 = readOperand(currentBB, reader, cp);
+    auto rhsOp2 = readOperand(currentBB, reader, cp);
+    auto lhsOp = readOperand(currentBB, reader, cp);
     currentBB.addNonTermInsn(
-        std::make_unique<BinaryOpInsn>(std::move(lhsOp), currentBB, std::move(rhsOp1), std::move(rhsOp2), kind));
+        currentBB.createInsn<BinaryOpInsn>(std::move(lhsOp), currentBB, std::move(rhsOp1), std::move(rhsOp2), kind));
 }
 
 // Read BRANCH Insn
-void BIRReadInsn::ReadCondBrInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
-    auto lhsOp = readOperand(reader, cp);
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadCondBrInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    auto lhsOp = readOperand(currentBB, reader, cp);
     int32_t trueBbIdNameCpIndex = reader.readS4be();
     int32_t falseBbIdNameCpIndex = reader.readS4be();
 
-    currentBB.setTerminatorInsn(std::make_unique<ConditionBrInsn>(
+    currentBB.setTerminatorInsn(currentBB.createInsn<ConditionBrInsn>(
         std::move(lhsOp), currentBB, cp.getStringCp(trueBbIdNameCpIndex), cp.getStringCp(falseBbIdNameCpIndex)));
 }
 
 // Read MOV Insn
-void BIRReadInsn::ReadMoveInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
-    auto rhsOp = readOperand(reader, cp);
-    auto lhsOp = readOperand(reader, cp);
-    currentBB.addNonTermInsn(std::make_unique<MoveInsn>(std::move(lhsOp), currentBB, std::move(rhsOp)));
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadMoveInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    auto rhsOp = readOperand(currentBB, reader, cp);
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    currentBB.addNonTermInsn(currentBB.createInsn<MoveInsn>(std::move(lhsOp), currentBB, std::move(rhsOp)));
 }
 
 // Read Function Call
-void BIRReadInsn::ReadFuncCallInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadFuncCallInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     [[maybe_unused]] uint8_t isVirtual = reader.readU1();
     [[maybe_unused]] int32_t packageIndex = reader.readS4be();
     int32_t callNameCpIndex = reader.readS4be();
-    std::string funcName = cp.getStringCp(callNameCpIndex);
+    auto funcName = cp.getStringCp(callNameCpIndex);
     int32_t argumentsCount = reader.readS4be();
 
     std::vector<Operand> fnArgs;
     fnArgs.reserve(argumentsCount);
     for (auto i = 0; i < argumentsCount; i++) {
-        fnArgs.push_back(readOperand(reader, cp));
+        fnArgs.push_back(readOperand(currentBB, reader, cp));
     }
 
     uint8_t hasLhsOperand = reader.readU1();
-    Operand lhsOp = (hasLhsOperand > 0) ? readOperand(reader, cp) : Operand("", NOT_A_KIND);
+    Operand lhsOp = (hasLhsOperand > 0) ? readOperand(currentBB, reader, cp) : Operand("", NOT_A_KIND);
 
     auto thenBbIdNameCpIndex = reader.readS4be();
 
-    currentBB.setTerminatorInsn(std::make_unique<FunctionCallInsn>(currentBB, cp.getStringCp(thenBbIdNameCpIndex),
-                                                                   std::move(lhsOp), std::move(funcName),
-                                                                   argumentsCount, std::move(fnArgs)));
+    currentBB.setTerminatorInsn(currentBB.createInsn<FunctionCallInsn>(currentBB, cp.getStringCp(thenBbIdNameCpIndex),
+                                                                      std::move(lhsOp), funcName, argumentsCount,
+                                                                      std::move(fnArgs)));
 }
 
 // Read TypeCast Insn
-void BIRReadInsn::ReadTypeCastInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
-    auto lhsOp = readOperand(reader, cp);
-    auto rhsOperand = readOperand(reader, cp);
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadTypeCastInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    auto rhsOperand = readOperand(currentBB, reader, cp);
 
     int32_t typeCpIndex = reader.readS4be();
-    Type typeDecl = cp.getTypeCp(typeCpIndex, false);
+    [[maybe_unused]] const Type &typeDecl = cp.getTypeCp(typeCpIndex, false);
     [[maybe_unused]] uint8_t isCheckTypes = reader.readU1();
 
-    currentBB.addNonTermInsn(std::make_unique<TypeCastInsn>(std::move(lhsOp), currentBB, std::move(rhsOperand)));
+    currentBB.addNonTermInsn(currentBB.createInsn<TypeCastInsn>(std::move(lhsOp), currentBB, std::move(rhsOperand)));
 }
 
 // Read Type Test Insn
-void BIRReadInsn::ReadTypeTestInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadTypeTestInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     int32_t typeCpIndex = reader.readS4be();
-    Type typeDecl = cp.getTypeCp(typeCpIndex, false);
-    auto lhsOp = readOperand(reader, cp);
-    [[maybe_unused]] auto rhsOperand = readOperand(reader, cp);
-    currentBB.addNonTermInsn(std::make_unique<TypeTestInsn>(std::move(lhsOp), currentBB));
+    [[maybe_unused]] const Type &typeDecl = cp.getTypeCp(typeCpIndex, false);
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    [[maybe_unused]] auto rhsOperand = readOperand(currentBB, reader, cp);
+    currentBB.addNonTermInsn(currentBB.createInsn<TypeTestInsn>(std::move(lhsOp), currentBB));
 }
 
 // Read Array Insn
-void BIRReadInsn::ReadArrayInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadArrayInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     int32_t typeCpIndex = reader.readS4be();
-    Type typeDecl = cp.getTypeCp(typeCpIndex, false);
-    auto lhsOp = readOperand(reader, cp);
-    auto sizeOperand = readOperand(reader, cp);
+    [[maybe_unused]] const Type &typeDecl = cp.getTypeCp(typeCpIndex, false);
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    auto sizeOperand = readOperand(currentBB, reader, cp);
 
     // TODO handle Array init values
     auto init_values_count = reader.readS4be();
     for (auto i = 0; i < init_values_count; i++) {
-        [[maybe_unused]] auto init_value = readOperand(reader, cp);
+        [[maybe_unused]] auto init_value = readOperand(currentBB, reader, cp);
     }
-    currentBB.addNonTermInsn(std::make_unique<ArrayInsn>(std::move(lhsOp), currentBB, std::move(sizeOperand)));
+    currentBB.addNonTermInsn(currentBB.createInsn<ArrayInsn>(std::move(lhsOp), currentBB, std::move(sizeOperand)));
 }
 
 // Read Array Store Insn
-void BIRReadInsn::ReadArrayStoreInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
-    auto lhsOp = readOperand(reader, cp);
-    auto keyOperand = readOperand(reader, cp);
-    auto rhsOperand = readOperand(reader, cp);
-    currentBB.addNonTermInsn(
-        std::make_unique<ArrayStoreInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadArrayStoreInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    auto keyOperand = readOperand(currentBB, reader, cp);
+    auto rhsOperand = readOperand(currentBB, reader, cp);
+    currentBB.addNonTermInsn(currentBB.createInsn<ArrayStoreInsn>(std::move(lhsOp), currentBB, std::move(keyOperand),
+                                                                  std::move(rhsOperand)));
 }
 
 // Read Array Load Insn
-void BIRReadInsn::ReadArrayLoadInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadArrayLoadInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     [[maybe_unused]] uint8_t optionalFieldAccess = reader.readU1();
     [[maybe_unused]] uint8_t fillingRead = reader.readU1();
-    auto lhsOp = readOperand(reader, cp);
-    auto keyOperand = readOperand(reader, cp);
-    auto rhsOperand = readOperand(reader, cp);
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    auto keyOperand = readOperand(currentBB, reader, cp);
+    auto rhsOperand = readOperand(currentBB, reader, cp);
     currentBB.addNonTermInsn(
-        std::make_unique<ArrayLoadInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
+        currentBB.createInsn<ArrayLoadInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
 }
 
 // Read Map Store Insn
-void BIRReadInsn::ReadMapStoreInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
-    auto lhsOp = readOperand(reader, cp);
-    auto keyOperand = readOperand(reader, cp);
-    auto rhsOperand = readOperand(reader, cp);
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadMapStoreInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    auto keyOperand = readOperand(currentBB, reader, cp);
+    auto rhsOperand = readOperand(currentBB, reader, cp);
     currentBB.addNonTermInsn(
-        std::make_unique<MapStoreInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
+        currentBB.createInsn<MapStoreInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
 }
 
 // Read Map Load Insn
-void BIRReadInsn::ReadMapLoadInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadMapLoadInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     [[maybe_unused]] uint8_t optionalFieldAccess = reader.readU1();
     [[maybe_unused]] uint8_t fillingRead = reader.readU1();
-    auto lhsOp = readOperand(reader, cp);
-    auto keyOperand = readOperand(reader, cp);
-    auto rhsOperand = readOperand(reader, cp);
+    auto lhsOp = readOperand(currentBB, reader, cp);
+    auto keyOperand = readOperand(currentBB, reader, cp);
+    auto rhsOperand = readOperand(currentBB, reader, cp);
     currentBB.addNonTermInsn(
-        std::make_unique<MapLoadInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
+        currentBB.createInsn<MapLoadInsn>(std::move(lhsOp), currentBB, std::move(keyOperand), std::move(rhsOperand)));
 }
 
-void BIRReadInsn::ReadGoToInsn(BasicBlock &currentBB, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadGoToInsn(BasicBlock &currentBB, ParserT &reader, ConstantPoolSet &cp) {
     auto nameId = reader.readS4be();
-    currentBB.setTerminatorInsn(std::make_unique<GoToInsn>(currentBB, cp.getStringCp(nameId)));
+    currentBB.setTerminatorInsn(currentBB.createInsn<GoToInsn>(currentBB, cp.getStringCp(nameId)));
 }
 
-void BIRReadInsn::ReadReturnInsn(BasicBlock &currentBB, Parser &, ConstantPoolSet &) {
-    currentBB.setTerminatorInsn(std::make_unique<ReturnInsn>(currentBB));
+template <typename ParserT>
+void BIRReadInsn<ParserT>::ReadReturnInsn(BasicBlock &currentBB, ParserT &, ConstantPoolSet &) {
+    currentBB.setTerminatorInsn(currentBB.createInsn<ReturnInsn>(currentBB));
 }
 
+template class BIRReadInsn<BIRStreamReader>;
+template class BIRReadInsn<BIRBufferReader>;
+
 } // namespace nballerina
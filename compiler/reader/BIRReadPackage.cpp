@@ -17,12 +17,15 @@
  */
 
 #include "reader/BIRReadPackage.h"
+#include "reader/BIRBufferReader.h"
 #include "reader/BIRReadFunction.h"
+#include "reader/BIRStreamReader.h"
 
 namespace nballerina {
 
 // Read Global Variable and push it to BIRPackage
-void BIRReadPackage::readGlobalVar(Package &birPackage, Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadPackage<ParserT>::readGlobalVar(Package &birPackage, ParserT &reader, ConstantPoolSet &cp) {
     uint8_t kind = reader.readU1();
 
     int32_t varDclNameCpIndex = reader.readS4be();
@@ -34,34 +37,24 @@ void BIRReadPackage::readGlobalVar(Package &birPackage, Parser &reader, Constant
     reader.ignore(docLength);
 
     int32_t typeCpIndex = reader.readS4be();
-    auto type = cp.getTypeCp(typeCpIndex, false);
-    birPackage.globalVars.emplace_back(std::move(type), cp.getStringCp(varDclNameCpIndex), (VarKind)kind);
+    const auto &type = cp.getTypeCp(typeCpIndex, false);
+    auto name = cp.getStringCp(varDclNameCpIndex);
+    birPackage.globalVarIndices.emplace(name, birPackage.globalVars.size());
+    birPackage.globalVars.emplace_back(type, name, (VarKind)kind);
 }
 
-std::shared_ptr<Package> BIRReadPackage::readModule(Parser &reader, ConstantPoolSet &cp) {
+template <typename ParserT>
+void BIRReadPackage<ParserT>::readModule(Package &birPackage, ParserT &reader, ConstantPoolSet &cp,
+                                         const ReaderOptions &options,
+                                         std::vector<PendingFunctionBody> *deferredBodies) {
 
     int32_t idCpIndex = reader.readS4be();
-    ConstantPoolEntry *poolEntry = cp.getEntry(idCpIndex);
-    auto birPackage = std::make_shared<Package>();
-
-    switch (poolEntry->getTag()) {
-    case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_PACKAGE: {
-        auto *packageEntry = static_cast<PackageCpInfo *>(poolEntry);
-        poolEntry = cp.getEntry(packageEntry->getOrgIndex());
-        auto *stringCp = static_cast<StringCpInfo *>(poolEntry);
-        birPackage->org = stringCp->getValue();
-
-        poolEntry = cp.getEntry(packageEntry->getNameIndex());
-        stringCp = static_cast<StringCpInfo *>(poolEntry);
-        birPackage->name = stringCp->getValue();
-
-        poolEntry = cp.getEntry(packageEntry->getVersionIndex());
-        stringCp = static_cast<StringCpInfo *>(poolEntry);
-        birPackage->version = stringCp->getValue();
-        break;
-    }
-    default:
-        break;
+
+    if (cp.getTag(idCpIndex) == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_PACKAGE) {
+        auto packageCp = cp.getPackageCp(idCpIndex);
+        birPackage.org = cp.getStringCp(packageCp.getOrgIndex());
+        birPackage.name = cp.getStringCp(packageCp.getNameIndex());
+        birPackage.version = cp.getStringCp(packageCp.getVersionIndex());
     }
 
     // The following three are read into unused variables so that the file
@@ -102,30 +95,48 @@ std::shared_ptr<Package> BIRReadPackage::readModule(Parser &reader, ConstantPool
     }
 
     int32_t globalVarCount = reader.readS4be();
-    birPackage->globalVars.reserve(globalVarCount);
+    birPackage.globalVars.reserve(globalVarCount);
+    birPackage.globalVarIndices.reserve(globalVarCount);
     for (auto i = 0; i < globalVarCount; i++) {
-        readGlobalVar(*birPackage, reader, cp);
+        readGlobalVar(birPackage, reader, cp);
     }
 
+    // Attached functions are not compiled, they are skipped
+    std::vector<PendingFunctionBody> pendingBodies;
     int32_t typeDefinitionBodiesCount = reader.readS4be();
     for (auto i = 0; i < typeDefinitionBodiesCount; i++) {
         int32_t attachedFunctionsCount = reader.readS4be();
         for (auto j = 0; j < attachedFunctionsCount; j++) {
-            BIRReadFunction::readFunction(*birPackage, reader, cp, true);
+            BIRReadFunction<ParserT>::readFunction(birPackage, reader, cp, pendingBodies, options.ignoredFunctions,
+                                                   true);
         }
         int32_t referencedTypesCount = reader.readS4be();
-        for (auto j = 0; j < referencedTypesCount; j++) {
-            [[maybe_unused]] int32_t referencedType = reader.readS4be();
-        }
+        reader.ignore(referencedTypesCount * sizeof(int32_t));
     }
 
     int32_t functionCount = reader.readS4be();
-    birPackage->functions.reserve(functionCount);
+    birPackage.functions.reserve(functionCount);
+    pendingBodies.reserve(functionCount);
     for (auto i = 0; i < functionCount; i++) {
-        BIRReadFunction::readFunction(*birPackage, reader, cp);
+        BIRReadFunction<ParserT>::readFunction(birPackage, reader, cp, pendingBodies, options.ignoredFunctions);
+    }
+    if (deferredBodies != nullptr) {
+        *deferredBodies = std::move(pendingBodies);
+    } else if (options.reachableOnly) {
+        BIRReadFunctionBody::readReachableFunctionBodies(birPackage, pendingBodies, cp, options.entryPoints,
+                                                         options.jobs);
+    } else {
+        BIRReadFunctionBody::readFunctionBodies(birPackage, pendingBodies, cp, options.jobs);
     }
 
-    return birPackage;
+    // Indexed last, as reachability pruning may have moved the functions
+    birPackage.functionIndices.reserve(birPackage.functions.size());
+    for (size_t i = 0; i < birPackage.functions.size(); i++) {
+        birPackage.functionIndices.emplace(birPackage.functions[i].getName(), i);
+    }
 }
 
+template class BIRReadPackage<BIRStreamReader>;
+template class BIRReadPackage<BIRBufferReader>;
+
 } // namespace nballerina
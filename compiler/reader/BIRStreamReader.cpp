@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "reader/BIRStreamReader.h"
+#include <algorithm>
+#include <iostream>
+
+namespace nballerina {
+
+BIRStreamReader::BIRStreamReader(std::unique_ptr<ByteSource> source)
+    : source(std::move(source)), buffer(new char[BUFFER_SIZE]), cursor(buffer.get()), bufferEnd(buffer.get()) {}
+
+// Replaces the (fully consumed) buffer contents; returns false at end of input
+bool BIRStreamReader::refill() {
+    size_t count = source->read(buffer.get(), BUFFER_SIZE);
+    cursor = buffer.get();
+    bufferEnd = cursor + count;
+    return count != 0;
+}
+
+void BIRStreamReader::readSlow(char *outBuff, std::streamsize length) {
+    if (length < 0) {
+        reportNegativeLength(length);
+    }
+    size_t pending = length;
+    while (pending > 0) {
+        if (available() == 0) {
+            // Large reads bypass the buffer to avoid an extra copy
+            if (pending >= BUFFER_SIZE) {
+                size_t count = source->read(outBuff, pending);
+                if (count == 0) {
+                    reportTruncated(length);
+                }
+                outBuff += count;
+                pending -= count;
+                continue;
+            }
+            if (!refill()) {
+                reportTruncated(length);
+            }
+        }
+        size_t count = std::min(pending, available());
+        std::memcpy(outBuff, cursor, count);
+        cursor += count;
+        outBuff += count;
+        pending -= count;
+    }
+}
+
+void BIRStreamReader::ignoreSlow(std::streamsize length) {
+    if (length < 0) {
+        reportNegativeLength(length);
+    }
+    size_t pending = length;
+    while (pending > 0) {
+        if (available() == 0 && !refill()) {
+            reportTruncated(length);
+        }
+        size_t count = std::min(pending, available());
+        cursor += count;
+        pending -= count;
+    }
+}
+
+void BIRStreamReader::reportTruncated(std::streamsize length) const {
+    std::cerr << "Unexpected end of BIR data: need " << length << " bytes" << std::endl;
+    abort();
+}
+
+// Same as the buffer reader, so that a corrupt length is rejected with either
+void BIRStreamReader::reportNegativeLength(std::streamsize length) const {
+    std::cerr << "Malformed BIR: negative length " << length << std::endl;
+    abort();
+}
+
+llvm::StringRef BIRStreamReader::readBlob(std::streamsize length) {
+    if (length < 0) {
+        reportNegativeLength(length);
+    }
+    if (length == 0) {
+        return llvm::StringRef();
+    }
+    char *blob = blobStorage.Allocate<char>(length);
+    readChars(blob, length);
+    return llvm::StringRef(blob, length);
+}
+
+} // namespace nballerina
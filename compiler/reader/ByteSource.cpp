@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "reader/ByteSource.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/Program.h>
+#ifdef NBALLERINA_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace nballerina {
+
+size_t ByteSource::read(char *outBuff, size_t length) {
+    if (pushedBack.empty()) {
+        return readSome(outBuff, length);
+    }
+    size_t count = std::min(length, pushedBack.size());
+    std::memcpy(outBuff, pushedBack.data(), count);
+    pushedBack.erase(0, count);
+    return count;
+}
+
+void ByteSource::unread(llvm::StringRef bytes) { pushedBack.insert(0, bytes.data(), bytes.size()); }
+
+FileByteSource::FileByteSource(llvm::sys::fs::file_t handle, bool ownsHandle)
+    : handle(handle), ownsHandle(ownsHandle) {}
+
+FileByteSource::~FileByteSource() {
+    if (ownsHandle) {
+        llvm::sys::fs::closeFile(handle);
+    }
+}
+
+size_t FileByteSource::readSome(char *outBuff, size_t length) {
+    auto countOrErr = llvm::sys::fs::readNativeFile(handle, llvm::MutableArrayRef<char>(outBuff, length));
+    if (!countOrErr) {
+        std::cerr << "Error while reading BIR input: " << llvm::toString(countOrErr.takeError()) << std::endl;
+        abort();
+    }
+    return *countOrErr;
+}
+
+#ifdef NBALLERINA_ENABLE_ZSTD
+// Streaming zstd decoder stacked on the raw input
+class ZstdByteSource final : public ByteSource {
+  private:
+    std::unique_ptr<ByteSource> compressed;
+    ZSTD_DStream *stream;
+    std::unique_ptr<char[]> inputBuffer;
+    ZSTD_inBuffer input;
+    bool inputEnded = false;
+    bool frameComplete = false;
+
+  protected:
+    size_t readSome(char *outBuff, size_t length) override {
+        ZSTD_outBuffer output{outBuff, length, 0};
+        while (true) {
+            if (input.pos == input.size && !inputEnded) {
+                input.size = compressed->read(inputBuffer.get(), ZSTD_DStreamInSize());
+                input.pos = 0;
+                inputEnded = input.size == 0;
+            }
+            size_t inputStart = input.pos;
+            size_t hint = ZSTD_decompressStream(stream, &output, &input);
+            if (ZSTD_isError(hint)) {
+                std::cerr << "Error while decompressing BIR input: " << ZSTD_getErrorName(hint) << std::endl;
+                abort();
+            }
+            if (output.pos > 0 || input.pos > inputStart) {
+                frameComplete = hint == 0;
+            }
+            if (output.pos > 0) {
+                return output.pos;
+            }
+            if (inputEnded && input.pos == input.size) {
+                if (!frameComplete) {
+                    std::cerr << "Error while decompressing BIR input: truncated zstd frame" << std::endl;
+                    abort();
+                }
+                return 0;
+            }
+        }
+    }
+
+  public:
+    ZstdByteSource(std::unique_ptr<ByteSource> compressed)
+        : compressed(std::move(compressed)), stream(ZSTD_createDStream()),
+          inputBuffer(new char[ZSTD_DStreamInSize()]), input{inputBuffer.get(), 0, 0} {
+        ZSTD_initDStream(stream);
+    }
+    ~ZstdByteSource() { ZSTD_freeDStream(stream); }
+};
+#endif
+
+std::unique_ptr<ByteSource> ByteSource::open(const std::string &FileName, std::string &errorMessage) {
+    std::unique_ptr<ByteSource> source;
+    if (FileName == "-") {
+        llvm::sys::ChangeStdinToBinary();
+        source = std::make_unique<FileByteSource>(llvm::sys::fs::getStdinHandle(), false);
+    } else {
+        auto handleOrErr = llvm::sys::fs::openNativeFileForRead(FileName);
+        if (!handleOrErr) {
+            errorMessage = llvm::toString(handleOrErr.takeError());
+            return nullptr;
+        }
+        source = std::make_unique<FileByteSource>(*handleOrErr, true);
+    }
+
+    // Sniff the frame magic without consuming it
+    char magic[ZSTD_MAGIC.size()];
+    size_t magicLength = 0;
+    while (magicLength < sizeof(magic)) {
+        size_t count = source->read(magic + magicLength, sizeof(magic) - magicLength);
+        if (count == 0) {
+            break;
+        }
+        magicLength += count;
+    }
+    source->unread(llvm::StringRef(magic, magicLength));
+    if (llvm::StringRef(magic, magicLength) != ZSTD_MAGIC) {
+        return source;
+    }
+#ifdef NBALLERINA_ENABLE_ZSTD
+    return std::make_unique<ZstdByteSource>(std::move(source));
+#else
+    errorMessage = "input is zstd compressed but zstd support is not enabled in this build";
+    return nullptr;
+#endif
+}
+
+} // namespace nballerina
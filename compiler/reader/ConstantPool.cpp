@@ -17,12 +17,16 @@
  */
 
 #include "reader/ConstantPool.h"
+#include "reader/BIRBufferReader.h"
+#include "reader/BIRStreamReader.h"
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 namespace nballerina {
 
-void TypeId::read(Parser &reader) {
+template <typename ParserT>
+void TypeId::read(ParserT &reader) {
     primaryTypeIdCount = reader.readS4be();
     primaryTypeId = std::vector<std::unique_ptr<TypeIdSet>>();
     primaryTypeId.reserve(primaryTypeIdCount);
@@ -41,13 +45,15 @@ void TypeId::read(Parser &reader) {
     }
 }
 
-void TypeIdSet::read(Parser &reader) {
+template <typename ParserT>
+void TypeIdSet::read(ParserT &reader) {
     pkgIdCpIndex = reader.readS4be();
     typeIdNameCpIndex = reader.readS4be();
     isPublicId = reader.readU1();
 }
 
-void ObjectField::read(Parser &reader) {
+template <typename ParserT>
+void ObjectField::read(ParserT &reader) {
     nameCpIndex = reader.readS4be();
     flags = reader.readS8be();
     doc = std::make_unique<Markdown>();
@@ -55,29 +61,27 @@ void ObjectField::read(Parser &reader) {
     typeCpIndex = reader.readS4be();
 }
 
-void Markdown::read(Parser &reader) {
+template <typename ParserT>
+void Markdown::read(ParserT &reader) {
     int32_t length = reader.readS4be();
-    for (auto i = 0; i < length; i++) {
-        [[maybe_unused]] int32_t body = reader.readS4be();
-    }
+    reader.ignore(length * sizeof(int32_t));
 }
 
-void ObjectAttachedFunction::read(Parser &reader) {
+template <typename ParserT>
+void ObjectAttachedFunction::read(ParserT &reader) {
     nameCpIndex = reader.readS4be();
     flags = reader.readS8be();
     typeCpIndex = reader.readS4be();
 }
 
-void TableFieldNameList::read(Parser &reader) {
+template <typename ParserT>
+void TableFieldNameList::read(ParserT &reader) {
     size = reader.readS4be();
-    fieldNameCpIndex = std::vector<int32_t>();
-    fieldNameCpIndex.reserve(size);
-    for (auto i = 0; i < size; i++) {
-        fieldNameCpIndex.push_back(reader.readS4be());
-    }
+    fieldNameCpIndex = reader.readS4beList(size);
 }
 
-void RecordField::read(Parser &reader) {
+template <typename ParserT>
+void RecordField::read(ParserT &reader) {
     nameCpIndex = reader.readS4be();
     flags = reader.readS8be();
     doc = std::make_unique<Markdown>();
@@ -85,33 +89,18 @@ void RecordField::read(Parser &reader) {
     typeCpIndex = reader.readS4be();
 }
 
-StringCpInfo::StringCpInfo() { setTag(TAG_ENUM_CP_ENTRY_STRING); }
-
-void StringCpInfo::read(Parser &reader) {
-    auto stringLength = reader.readS4be();
-    std::vector<char> result(stringLength);
-    reader.readChars(result.data(), stringLength);
-    value = std::string(result.data(), stringLength);
-}
-
-ShapeCpInfo::ShapeCpInfo() { setTag(TAG_ENUM_CP_ENTRY_SHAPE); }
-
-void ShapeCpInfo::read(Parser &reader) {
-    shapeLength = reader.readS4be();
+template <typename ParserT>
+void ShapeCpInfo::read(ParserT &reader) {
     typeTag = TypeTag(reader.readU1());
     nameIndex = reader.readS4be();
     typeFlag = reader.readS8be();
     typeSpecialFlag = reader.readS4be();
-    [[maybe_unused]] int32_t shapeTypeLengthInfo = shapeLength - 13;
     switch (typeTag) {
     case TYPE_TAG_INVOKABLE: {
         uint8_t isAnyFunction = reader.readU1();
         if (isAnyFunction == 0U) {
             paramCount = reader.readS4be();
-            for (auto i = 0; i < paramCount; i++) {
-                int32_t paramTypeCpIndex = reader.readS4be();
-                addParam(paramTypeCpIndex);
-            }
+            params = reader.readS4beList(paramCount);
             hasRestType = reader.readU1();
             if (hasRestType != 0U) {
                 restTypeIndex = reader.readS4be();
@@ -186,11 +175,7 @@ void ShapeCpInfo::read(Parser &reader) {
             objectAttachedFunctions.push_back(std::move(objectAttachedFunction));
         }
         int32_t typeInclusionsCount = reader.readS4be();
-        auto typeInclusionsCpIndex = std::vector<int32_t>();
-        typeInclusionsCpIndex.reserve(typeInclusionsCount);
-        for (auto i = 0; i < typeInclusionsCount; i++) {
-            typeInclusionsCpIndex.push_back(reader.readS4be());
-        }
+        [[maybe_unused]] auto typeInclusionsCpIndex = reader.readS4beList(typeInclusionsCount);
         auto typeIds = std::make_unique<TypeId>();
         typeIds->read(reader);
         break;
@@ -202,38 +187,22 @@ void ShapeCpInfo::read(Parser &reader) {
             [[maybe_unused]] int32_t pkdIdCpIndex = reader.readS4be();
             [[maybe_unused]] int32_t nameCpIndex = reader.readS4be();
         }
-        [[maybe_unused]] int32_t memberTypeCount = reader.readS4be();
-        auto memberTypeCpIndex = std::vector<int32_t>();
-        memberTypeCpIndex.reserve(memberTypeCount);
-        for (auto i = 0; i < memberTypeCount; i++) {
-            memberTypeCpIndex.push_back(reader.readS4be());
-        }
-        [[maybe_unused]] int32_t originalMemberTypeCount = reader.readS4be();
-        auto originalMemberTypeCpIndex = std::vector<int32_t>();
-        originalMemberTypeCpIndex.reserve(originalMemberTypeCount);
-        for (auto i = 0; i < originalMemberTypeCount; i++) {
-            originalMemberTypeCpIndex.push_back(reader.readS4be());
-        }
+        int32_t memberTypeCount = reader.readS4be();
+        [[maybe_unused]] auto memberTypeCpIndex = reader.readS4beList(memberTypeCount);
+        int32_t originalMemberTypeCount = reader.readS4be();
+        [[maybe_unused]] auto originalMemberTypeCpIndex = reader.readS4beList(originalMemberTypeCount);
         uint8_t isEnumType = reader.readU1();
         if (isEnumType != 0U) {
             [[maybe_unused]] int32_t pkgCpIndex = reader.readS4be();
             [[maybe_unused]] int32_t enumName = reader.readS4be();
-            [[maybe_unused]] int32_t enumMemberSize = reader.readS4be();
-            auto enumMembers = std::vector<int32_t>();
-            enumMembers.reserve(enumMemberSize);
-            for (auto i = 0; i < enumMemberSize; i++) {
-                enumMembers.push_back(reader.readS4be());
-            }
+            int32_t enumMemberSize = reader.readS4be();
+            [[maybe_unused]] auto enumMembers = reader.readS4beList(enumMemberSize);
         }
         break;
     }
     case TYPE_TAG_TUPLE: {
-        [[maybe_unused]] int32_t tupleTypesCount = reader.readS4be();
-        auto tupleTypeCpIndex = std::vector<int32_t>();
-        tupleTypeCpIndex.reserve(tupleTypesCount);
-        for (auto i = 0; i < tupleTypesCount; i++) {
-            tupleTypeCpIndex.push_back(reader.readS4be());
-        }
+        int32_t tupleTypesCount = reader.readS4be();
+        [[maybe_unused]] auto tupleTypeCpIndex = reader.readS4beList(tupleTypesCount);
         hasRestType = reader.readU1();
         if (hasRestType != 0U) {
             [[maybe_unused]] int32_t restTypeCpIndex = reader.readS4be();
@@ -241,12 +210,8 @@ void ShapeCpInfo::read(Parser &reader) {
         break;
     }
     case TYPE_TAG_INTERSECTION: {
-        [[maybe_unused]] int32_t constituentTypesCount = reader.readS4be();
-        auto constituentTypeCpIndex = std::vector<int32_t>();
-        constituentTypeCpIndex.reserve(constituentTypesCount);
-        for (auto i = 0; i < constituentTypesCount; i++) {
-            constituentTypeCpIndex.push_back(reader.readS4be());
-        }
+        int32_t constituentTypesCount = reader.readS4be();
+        [[maybe_unused]] auto constituentTypeCpIndex = reader.readS4beList(constituentTypesCount);
         [[maybe_unused]] int32_t effectiveTypeCount = reader.readS4be();
         break;
     }
@@ -285,12 +250,8 @@ void ShapeCpInfo::read(Parser &reader) {
             auto recordInitFunction = std::make_unique<ObjectAttachedFunction>();
             recordInitFunction->read(reader);
         }
-        [[maybe_unused]] int32_t typeInclusionsCount = reader.readS4be();
-        auto typeInclusionsCpIndex = std::vector<int32_t>();
-        typeInclusionsCpIndex.reserve(typeInclusionsCount);
-        for (auto i = 0; i < typeInclusionsCount; i++) {
-            typeInclusionsCpIndex.push_back(reader.readS4be());
-        }
+        int32_t typeInclusionsCount = reader.readS4be();
+        [[maybe_unused]] auto typeInclusionsCpIndex = reader.readS4beList(typeInclusionsCount);
         break;
     }
     case TYPE_TAG_FINITE: {
@@ -300,9 +261,7 @@ void ShapeCpInfo::read(Parser &reader) {
         for (auto i = 0; i < valueSpaceSize; i++) {
             [[maybe_unused]] int32_t fTypeCpIndex = reader.readS4be();
             int32_t valueLength = reader.readS4be();
-            for (auto j = 0; j < valueLength; j++) {
-                [[maybe_unused]] int8_t tmp = reader.readU1();
-            }
+            reader.ignore(valueLength);
         }
         break;
     }
@@ -361,131 +320,161 @@ PackageCpInfo::PackageCpInfo() {
     orgIndex = 0;
     nameIndex = 0;
     versionIndex = 0;
-    setTag(TAG_ENUM_CP_ENTRY_PACKAGE);
 }
 
-void PackageCpInfo::read(Parser &reader) {
+template <typename ParserT>
+void PackageCpInfo::read(ParserT &reader) {
     orgIndex = reader.readS4be();
     nameIndex = reader.readS4be();
     versionIndex = reader.readS4be();
 }
 
-IntCpInfo::IntCpInfo() { setTag(TAG_ENUM_CP_ENTRY_INTEGER); }
-
-void IntCpInfo::read(Parser &reader) { value = reader.readS8be(); }
-
-BooleanCpInfo::BooleanCpInfo() { setTag(TAG_ENUM_CP_ENTRY_BOOLEAN); }
-
-void BooleanCpInfo::read(Parser &reader) { value = reader.readU1(); }
-
-FloatCpInfo::FloatCpInfo() { setTag(TAG_ENUM_CP_ENTRY_FLOAT); }
+ConstantPoolSet::ConstantPoolSet(SymbolTable &symbols, TypeTable &typeTable) : symbols(symbols), typeTable(typeTable) {}
 
-void FloatCpInfo::read(Parser &reader) { value = reader.readS8bef(); }
-
-ByteCpInfo::ByteCpInfo() { setTag(TAG_ENUM_CP_ENTRY_BYTE); }
-
-void ByteCpInfo::read(Parser &reader) { value = reader.readU1(); }
+ConstantPoolSet::~ConstantPoolSet() {
+    for (auto &shape : shapes) {
+        delete shape.load();
+    }
+}
 
-void ConstantPoolSet::read(Parser &reader) {
+template <typename ParserT>
+void ConstantPoolSet::read(ParserT &reader) {
 
     int constantPoolEntries = reader.readS4be();
-    poolEntries = std::vector<std::unique_ptr<ConstantPoolEntry>>();
-    poolEntries.reserve(constantPoolEntries);
+    tags.reserve(constantPoolEntries);
+    values.reserve(constantPoolEntries);
 
+    // Only record where each entry lives; packages and shapes are decoded on
+    // first use
     for (auto i = 0; i < constantPoolEntries; i++) {
         auto tag = static_cast<ConstantPoolEntry::tagEnum>(reader.readU1());
+        uint64_t value = 0;
         switch (tag) {
         case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_PACKAGE: {
-            auto poolEntry = std::make_unique<PackageCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
+            value = blobs.size();
+            blobs.push_back(reader.readBlob(3 * sizeof(int32_t)));
             break;
         }
         case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE: {
-            auto poolEntry = std::make_unique<ShapeCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
+            int32_t shapeLength = reader.readS4be();
+            // getTypeTag reads the first byte without decoding the shape
+            if (shapeLength == 0) {
+                std::cerr << "Malformed BIR: empty shape at constant pool index " << i << std::endl;
+                abort();
+            }
+            value = shapeBlobs.size();
+            shapeBlobs.push_back(reader.readBlob(shapeLength));
             break;
         }
         case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_STRING: {
-            auto poolEntry = std::make_unique<StringCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
+            int32_t stringLength = reader.readS4be();
+            llvm::StringRef blob = reader.readBlob(stringLength);
+            value = strings.size();
+            strings.push_back(symbols.intern(std::string_view(blob.data(), blob.size())));
             break;
         }
         case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_INTEGER: {
-            auto poolEntry = std::make_unique<IntCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
+            value = reader.readS8be();
             break;
         }
         case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_FLOAT: {
-            auto poolEntry = std::make_unique<FloatCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
-            break;
-        }
-        case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_BOOLEAN: {
-            auto poolEntry = std::make_unique<BooleanCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
+            double floatValue = reader.readS8bef();
+            std::memcpy(&value, &floatValue, sizeof(value));
             break;
         }
+        case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_BOOLEAN:
         case ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_BYTE: {
-            auto poolEntry = std::make_unique<ByteCpInfo>();
-            poolEntry->read(reader);
-            poolEntries.push_back(std::move(poolEntry));
+            value = reader.readU1();
             break;
         }
         default:
-            break;
+            continue;
         }
+        tags.push_back(tag);
+        values.push_back(value);
+    }
+    shapes = std::vector<std::atomic<ShapeCpInfo *>>(shapeBlobs.size());
+    types = std::vector<std::atomic<const Type *>>(2 * shapeBlobs.size());
+}
+
+template void ConstantPoolSet::read<BIRStreamReader>(BIRStreamReader &reader);
+template void ConstantPoolSet::read<BIRBufferReader>(BIRBufferReader &reader);
+
+uint64_t ConstantPoolSet::valueOf(int32_t index, [[maybe_unused]] ConstantPoolEntry::tagEnum tag) {
+    assert(getTag(index) == tag);
+    return values[index];
+}
+
+// Decode the shape on first use. Racing decoders may both decode the shape,
+// only the first one to publish it is kept.
+ShapeCpInfo &ConstantPoolSet::getShapeCp(int32_t index) {
+    auto slot = valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
+    ShapeCpInfo *shape = shapes[slot].load(std::memory_order_acquire);
+    if (shape != nullptr) {
+        return *shape;
+    }
+    llvm::StringRef shapeBlob = shapeBlobs[slot];
+    BIRBufferReader shapeReader{shapeBlob};
+    auto decoded = std::make_unique<ShapeCpInfo>();
+    decoded->setShapeLength(shapeBlob.size());
+    decoded->read(shapeReader);
+    if (shapes[slot].compare_exchange_strong(shape, decoded.get(), std::memory_order_acq_rel)) {
+        return *decoded.release();
     }
+    return *shape;
 }
 
 // Search string from the constant pool based on index
-std::string ConstantPoolSet::getStringCp(int32_t index) {
-    ConstantPoolEntry *poolEntry = getEntry(index);
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_STRING);
-    auto *stringCp = static_cast<StringCpInfo *>(poolEntry);
-    return stringCp->getValue();
+std::string_view ConstantPoolSet::getStringCp(int32_t index) {
+    return strings[valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_STRING)];
 }
 
 // Search string from the constant pool based on index
 int64_t ConstantPoolSet::getIntCp(int32_t index) {
-    ConstantPoolEntry *poolEntry = getEntry(index);
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_INTEGER);
-    auto *intCp = static_cast<IntCpInfo *>(poolEntry);
-    return intCp->getValue();
+    return static_cast<int64_t>(valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_INTEGER));
 }
 
 // Search float from the constant pool based on index
 double ConstantPoolSet::getFloatCp(int32_t index) {
-    ConstantPoolEntry *poolEntry = getEntry(index);
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_FLOAT);
-    auto *floatCp = static_cast<FloatCpInfo *>(poolEntry);
-    return floatCp->getValue();
+    uint64_t bits = valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_FLOAT);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
 }
 
 // Search boolean from the constant pool based on index
 bool ConstantPoolSet::getBooleanCp(int32_t index) {
-    ConstantPoolEntry *poolEntry = getEntry(index);
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_BOOLEAN);
-    auto *booleanCp = static_cast<BooleanCpInfo *>(poolEntry);
-    return (booleanCp->getValue() != 0u);
+    return valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_BOOLEAN) != 0u;
+}
+
+// Search package from the constant pool based on index
+PackageCpInfo ConstantPoolSet::getPackageCp(int32_t index) {
+    BIRBufferReader packageReader{blobs[valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_PACKAGE)]};
+    PackageCpInfo packageCp;
+    packageCp.read(packageReader);
+    return packageCp;
 }
 
 // Search type from the constant pool based on index
-Type ConstantPoolSet::getTypeCp(int32_t index, bool voidToInt) {
-    ConstantPoolEntry *poolEntry = getEntry(index);
+const Type &ConstantPoolSet::getTypeCp(int32_t index, bool voidToInt) {
+    auto slot = 2 * valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE) + (voidToInt ? 1 : 0);
+    const Type *type = types[slot].load(std::memory_order_acquire);
+    if (type == nullptr) {
+        // Racing decoders intern to the same record, so a plain store is enough
+        type = &typeTable.intern(decodeType(index, voidToInt));
+        types[slot].store(type, std::memory_order_release);
+    }
+    return *type;
+}
 
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
-    auto *shapeCp = static_cast<ShapeCpInfo *>(poolEntry);
+Type ConstantPoolSet::decodeType(int32_t index, bool voidToInt) {
+    auto *shapeCp = &getShapeCp(index);
 
-    std::string name = getStringCp(shapeCp->getNameIndex());
-    // if name is empty, create a random name anon-<5-digits>
+    std::string name(getStringCp(shapeCp->getNameIndex()));
+    // Anonymous types are named after their shape, which keeps names stable
+    // across runs
     if (name.empty()) {
-        name.append("anon-" + std::to_string(std::rand() % 100000));
+        name.append("anon-" + std::to_string(index));
     }
     auto type = TypeTag(shapeCp->getTypeTag());
 
@@ -495,19 +484,14 @@ Type ConstantPoolSet::getTypeCp(int32_t index, bool voidToInt) {
     }
     // Handle Map type
     if (type == TYPE_TAG_MAP) {
-        ConstantPoolEntry *shapeEntry = getEntry(shapeCp->getConstraintTypeCpIndex());
-        assert(shapeEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
-        auto *typeShapeCp = static_cast<ShapeCpInfo *>(shapeEntry);
-        return Type(type, name, Type::MapType{typeShapeCp->getTypeTag()});
+        return Type(type, name, Type::MapType{getTypeTag(shapeCp->getConstraintTypeCpIndex())});
     }
 
     // Handle Array type
     if (type == TYPE_TAG_ARRAY) {
-        ConstantPoolEntry *shapeEntry = getEntry(shapeCp->getElementTypeCpIndex());
-        assert(shapeEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
-        auto *memberShapeCp = static_cast<ShapeCpInfo *>(shapeEntry);
         return Type(type, name,
-                    Type::ArrayType{memberShapeCp->getTypeTag(), (int)shapeCp->getSize(), shapeCp->getState()});
+                    Type::ArrayType{getTypeTag(shapeCp->getElementTypeCpIndex()), (int)shapeCp->getSize(),
+                                    shapeCp->getState()});
     }
     // Default return
     return Type(type, name);
@@ -515,27 +499,23 @@ Type ConstantPoolSet::getTypeCp(int32_t index, bool voidToInt) {
 
 // Get the Type tag from the constant pool based on the index passed
 TypeTag ConstantPoolSet::getTypeTag(int32_t index) {
-    ConstantPoolEntry *poolEntry = getEntry(index);
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
-    auto *shapeCp = static_cast<ShapeCpInfo *>(poolEntry);
-    return shapeCp->getTypeTag();
+    // The tag is the first byte of the shape, no need to decode the rest
+    auto slot = valueOf(index, ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
+    return TypeTag(static_cast<uint8_t>(shapeBlobs[slot].front()));
 }
 
 // Search type from the constant pool based on index
 InvocableType ConstantPoolSet::getInvocableType(int32_t index) {
-
-    ConstantPoolEntry *poolEntry = getEntry(index);
-    assert(poolEntry->getTag() == ConstantPoolEntry::tagEnum::TAG_ENUM_CP_ENTRY_SHAPE);
-    auto *shapeCp = static_cast<ShapeCpInfo *>(poolEntry);
+    auto *shapeCp = &getShapeCp(index);
     auto paramCount = shapeCp->getParamCount();
-    std::vector<Type> paramTypes;
+    std::vector<const Type *> paramTypes;
     paramTypes.reserve(paramCount);
     for (auto i = 0; i < paramCount; i++) {
-        paramTypes.push_back(getTypeCp(shapeCp->getParam(i), false));
+        paramTypes.push_back(&getTypeCp(shapeCp->getParam(i), false));
     }
-    auto returnTypeDecl = getTypeCp(shapeCp->getReturnTypeIndex(), false);
+    const auto &returnTypeDecl = getTypeCp(shapeCp->getReturnTypeIndex(), false);
     if (shapeCp->getRestType() != 0U) {
-        auto restTypeDecl = getTypeCp(shapeCp->getRestTypeIndex(), false);
+        const auto &restTypeDecl = getTypeCp(shapeCp->getRestTypeIndex(), false);
         return InvocableType(std::move(paramTypes), restTypeDecl, returnTypeDecl);
     }
     return InvocableType(std::move(paramTypes), returnTypeDecl);
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "reader/FunctionIgnoreList.h"
+#include <algorithm>
+
+namespace nballerina {
+
+FunctionIgnoreList::FunctionIgnoreList() {
+    for (const char *prefix : {".<init>", ".<start>", ".<stop>", "..<init>", "..<start>", "..<stop>"}) {
+        addPrefix(prefix);
+    }
+}
+
+void FunctionIgnoreList::addPrefix(std::string_view prefix) {
+    prefixes.insert(llvm::StringRef(prefix.data(), prefix.size()));
+    prefixLengths.insert(prefix.size());
+}
+
+void FunctionIgnoreList::clear() {
+    prefixes.clear();
+    prefixLengths.clear();
+}
+
+bool FunctionIgnoreList::isIgnored(std::string_view functionName) const {
+    for (auto length : prefixLengths) {
+        if (length > functionName.size()) {
+            break;
+        }
+        if (prefixes.count(llvm::StringRef(functionName.data(), length)) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string_view> FunctionIgnoreList::getPrefixes() const {
+    std::vector<std::string_view> sortedPrefixes;
+    sortedPrefixes.reserve(prefixes.size());
+    for (const auto &prefix : prefixes) {
+        sortedPrefixes.emplace_back(prefix.getKey().data(), prefix.getKey().size());
+    }
+    std::sort(sortedPrefixes.begin(), sortedPrefixes.end());
+    return sortedPrefixes;
+}
+
+} // namespace nballerina
@@ -0,0 +1,835 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "reader/PackageCache.h"
+#include "bir/ArrayInstructions.h"
+#include "bir/BasicBlock.h"
+#include "bir/BinaryOpInsn.h"
+#include "bir/ConditionBrInsn.h"
+#include "bir/ConstantLoad.h"
+#include "bir/Function.h"
+#include "bir/FunctionCallInsn.h"
+#include "bir/GoToInsn.h"
+#include "bir/MapInsns.h"
+#include "bir/MoveInsn.h"
+#include "bir/ReturnInsn.h"
+#include "bir/StructureInsn.h"
+#include "bir/TypeCastInsn.h"
+#include "bir/TypeDescInsn.h"
+#include "bir/TypeTestInsn.h"
+#include "bir/UnaryOpInsn.h"
+#include <llvm/Support/Endian.h>
+#include <llvm/Support/EndianStream.h>
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+#include <cstring>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace nballerina {
+
+// Collects the package body and the strings it refers to
+class PackageCacheWriter {
+  private:
+    std::unordered_map<std::string_view, uint32_t> stringIds;
+
+  public:
+    std::vector<std::string_view> strings;
+    std::string body;
+    llvm::raw_string_ostream out{body};
+
+    template <typename T>
+    void write(T value) {
+        llvm::support::endian::write(out, value, llvm::support::little);
+    }
+
+    void writeString(std::string_view value) {
+        auto result = stringIds.emplace(value, static_cast<uint32_t>(strings.size()));
+        if (result.second) {
+            strings.push_back(value);
+        }
+        write<uint32_t>(result.first->second);
+    }
+
+    void writeType(const Type &type) { write<uint32_t>(type.getIndex()); }
+
+    void writeOperand(const Operand &operand) {
+        write<uint8_t>(operand.getKind());
+        writeString(operand.getName());
+        write<uint32_t>(operand.getIndex());
+    }
+};
+
+// Bounds checked cursor over a cache file. Running off the end or reading a
+// bad string or type index marks the reader failed rather than aborting, and
+// the entry is then ignored.
+class PackageCacheReader {
+  private:
+    const char *cursor;
+    const char *bufferEnd;
+    bool failed = false;
+
+  public:
+    std::vector<std::string_view> strings;
+    const TypeTable *types = nullptr;
+
+    PackageCacheReader(llvm::StringRef buffer) : cursor(buffer.begin()), bufferEnd(buffer.end()) {}
+
+    bool hasFailed() const { return failed; }
+    bool atEnd() const { return cursor == bufferEnd; }
+    llvm::StringRef remaining() const { return llvm::StringRef(cursor, bufferEnd - cursor); }
+
+    void fail() {
+        failed = true;
+        cursor = bufferEnd;
+    }
+
+    template <typename T>
+    T read() {
+        if (static_cast<size_t>(bufferEnd - cursor) < sizeof(T)) {
+            fail();
+            return T{};
+        }
+        T value = llvm::support::endian::read<T, llvm::support::little, llvm::support::unaligned>(cursor);
+        cursor += sizeof(T);
+        return value;
+    }
+
+    llvm::StringRef readBytes(size_t length) {
+        if (static_cast<size_t>(bufferEnd - cursor) < length) {
+            fail();
+            return {};
+        }
+        llvm::StringRef bytes(cursor, length);
+        cursor += length;
+        return bytes;
+    }
+
+    // A damaged count could otherwise ask for a huge allocation, so it is
+    // checked against the bytes left, each element taking at least minSize
+    uint32_t readCount(size_t minSize = 1) {
+        auto count = read<uint32_t>();
+        if (count > static_cast<size_t>(bufferEnd - cursor) / minSize) {
+            fail();
+            return 0;
+        }
+        return count;
+    }
+
+    std::string_view readString() {
+        auto id = read<uint32_t>();
+        if (id >= strings.size()) {
+            fail();
+            return {};
+        }
+        return strings[id];
+    }
+
+    const Type *readType() {
+        auto index = read<uint32_t>();
+        if (types == nullptr || index >= types->size()) {
+            fail();
+            return nullptr;
+        }
+        return &types->get(index);
+    }
+
+    Operand readOperand() {
+        auto kind = (VarKind)read<uint8_t>();
+        auto name = readString();
+        auto index = read<uint32_t>();
+        return Operand(name, kind, index);
+    }
+};
+
+uint64_t PackageCache::getKey(llvm::StringRef dump, const ReaderOptions &options) {
+    // Length prefixed, so that adjacent fields can not run together
+    std::string optionsKey;
+    llvm::raw_string_ostream optionsStream(optionsKey);
+    optionsStream << FORMAT_VERSION << ':' << llvm::xxHash64(dump) << ':' << options.reachableOnly;
+    for (auto prefix : options.ignoredFunctions.getPrefixes()) {
+        optionsStream << ":i" << prefix.size() << ':' << llvm::StringRef(prefix.data(), prefix.size());
+    }
+    for (const auto &entryPoint : options.entryPoints) {
+        optionsStream << ":e" << entryPoint.size() << ':' << entryPoint;
+    }
+    return llvm::xxHash64(optionsStream.str());
+}
+
+std::string PackageCache::getPath(const std::string &directory, uint64_t key) {
+    std::string fileName;
+    llvm::raw_string_ostream fileNameStream(fileName);
+    fileNameStream << llvm::format_hex_no_prefix(key, 16) << ".nbpc";
+    llvm::SmallString<256> path(directory);
+    llvm::sys::path::append(path, fileNameStream.str());
+    return std::string(path);
+}
+
+std::shared_ptr<Package> PackageCache::load(const std::string &path, uint64_t key) {
+    auto fileOrErr = llvm::MemoryBuffer::getFile(path, -1, false);
+    if (!fileOrErr) {
+        return nullptr;
+    }
+    PackageCacheReader reader((*fileOrErr)->getBuffer());
+    if (reader.readBytes(MAGIC.size()) != MAGIC || reader.read<uint32_t>() != FORMAT_VERSION ||
+        reader.read<uint64_t>() != key) {
+        return nullptr;
+    }
+    // Catches damage that would still decode, like changed string bytes
+    auto checksum = reader.read<uint64_t>();
+    if (reader.hasFailed() || llvm::xxHash64(reader.remaining()) != checksum) {
+        return nullptr;
+    }
+    auto stringCount = reader.readCount(sizeof(uint32_t));
+    std::vector<uint32_t> lengths(stringCount);
+    for (auto &length : lengths) {
+        length = reader.read<uint32_t>();
+    }
+    reader.strings.reserve(stringCount);
+    for (auto length : lengths) {
+        auto bytes = reader.readBytes(length);
+        reader.strings.emplace_back(bytes.data(), bytes.size());
+    }
+
+    auto package = std::make_shared<Package>();
+    if (!readPackage(reader, *package) || reader.hasFailed() || !reader.atEnd()) {
+        return nullptr;
+    }
+    package->backingBuffer = std::move(*fileOrErr);
+    return package;
+}
+
+bool PackageCache::store(const Package &package, const std::string &path, uint64_t key) {
+    PackageCacheWriter writer;
+    writePackage(writer, package);
+    writer.out.flush();
+
+    auto directory = llvm::sys::path::parent_path(path);
+    if (!directory.empty() && llvm::sys::fs::create_directories(directory)) {
+        return false;
+    }
+    auto tempPath = path + "." + std::to_string(llvm::sys::Process::getProcessId()) + ".tmp";
+    {
+        std::error_code EC;
+        llvm::raw_fd_ostream file(tempPath, EC, llvm::sys::fs::OF_None);
+        if (EC) {
+            return false;
+        }
+        std::string payload;
+        llvm::raw_string_ostream payloadStream(payload);
+        llvm::support::endian::write<uint32_t>(payloadStream, writer.strings.size(), llvm::support::little);
+        for (auto value : writer.strings) {
+            llvm::support::endian::write<uint32_t>(payloadStream, value.size(), llvm::support::little);
+        }
+        for (auto value : writer.strings) {
+            payloadStream << llvm::StringRef(value.data(), value.size());
+        }
+        payloadStream << writer.body;
+        payloadStream.flush();
+
+        file << MAGIC;
+        llvm::support::endian::write<uint32_t>(file, FORMAT_VERSION, llvm::support::little);
+        llvm::support::endian::write<uint64_t>(file, key, llvm::support::little);
+        llvm::support::endian::write<uint64_t>(file, llvm::xxHash64(payload), llvm::support::little);
+        file << payload;
+        file.close();
+        if (file.has_error()) {
+            file.clear_error();
+            llvm::sys::fs::remove(tempPath);
+            return false;
+        }
+    }
+    if (llvm::sys::fs::rename(tempPath, path)) {
+        llvm::sys::fs::remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+void PackageCache::writePackage(PackageCacheWriter &writer, const Package &package) {
+    writer.writeString(package.org);
+    writer.writeString(package.name);
+    writer.writeString(package.version);
+    writer.writeString(package.sourceFileName);
+
+    // In index order, so that interning them again gives the same indices
+    const auto &types = package.getTypeTable();
+    writer.write<uint32_t>(types.size());
+    for (TypeIndex i = 0; i < types.size(); i++) {
+        const auto &type = types.get(i);
+        writer.write<uint8_t>(type.getTypeTag());
+        writer.writeString(type.getName());
+        if (type.getTypeTag() == TYPE_TAG_ARRAY) {
+            const auto &arrayType = type.getArrayType();
+            writer.write<uint8_t>(arrayType.memberType);
+            writer.write<int32_t>(arrayType.size);
+            writer.write<int32_t>(arrayType.state);
+        } else if (type.getTypeTag() == TYPE_TAG_MAP) {
+            writer.write<uint8_t>(type.getMemberTypeTag());
+        }
+    }
+
+    writer.write<uint32_t>(package.globalVars.size());
+    for (const auto &globalVar : package.globalVars) {
+        writer.writeType(globalVar.getType());
+        writer.writeString(globalVar.getName());
+        writer.write<uint8_t>(globalVar.getKind());
+    }
+
+    writer.write<uint32_t>(package.functions.size());
+    for (const auto &function : package.functions) {
+        writeFunction(writer, function);
+    }
+}
+
+void PackageCache::writeFunction(PackageCacheWriter &writer, const Function &function) {
+    writer.writeString(function.name);
+    writer.writeString(function.workerName);
+    writer.write<uint32_t>(function.flags);
+    const auto &location = function.getLocation();
+    writer.writeString(location.getFileName());
+    writer.write<int32_t>(location.getStartLineNum());
+    writer.write<int32_t>(location.getStartColumnNum());
+    writer.write<int32_t>(location.getEndLineNum());
+    writer.write<int32_t>(location.getEndColumnNum());
+
+    writer.write<uint8_t>(function.signature.has_value());
+    if (function.signature) {
+        writer.write<uint32_t>(function.signature->getParamTypes().size());
+        for (const auto *paramType : function.signature->getParamTypes()) {
+            writer.writeType(*paramType);
+        }
+        writer.writeType(function.signature->getReturnType());
+        writer.write<uint8_t>(function.signature->getRestType() != nullptr);
+        if (function.signature->getRestType() != nullptr) {
+            writer.writeType(*function.signature->getRestType());
+        }
+    }
+    writer.write<uint8_t>(function.returnVar.has_value());
+    if (function.returnVar) {
+        writer.writeType(function.returnVar->getType());
+        writer.writeString(function.returnVar->getName());
+        writer.write<uint8_t>(function.returnVar->getKind());
+    }
+    writer.write<uint8_t>(function.restParam.has_value());
+
+    writer.write<uint32_t>(function.requiredParams.size());
+    for (const auto &param : function.requiredParams) {
+        writer.writeOperand(param);
+        writer.writeType(param.getType());
+    }
+    writer.write<uint32_t>(function.localVars.size());
+    for (const auto &localVar : function.localVars) {
+        writer.writeType(localVar.getType());
+        writer.writeString(localVar.getName());
+        writer.write<uint8_t>(localVar.getKind());
+    }
+
+    writer.write<uint32_t>(function.basicBlocks.size());
+    for (const auto *basicBlock : function.basicBlocks) {
+        writer.writeString(basicBlock->getId());
+        writer.write<uint32_t>(basicBlock->instructions.size());
+        for (const auto *insn : basicBlock->instructions) {
+            writeInstruction(writer, *insn);
+        }
+        const auto *terminator = basicBlock->getTerminatorInsnPtr();
+        writer.write<uint8_t>(terminator != nullptr);
+        if (terminator != nullptr) {
+            writeTerminator(writer, *terminator);
+        }
+    }
+}
+
+void PackageCache::writeInstruction(PackageCacheWriter &writer, const NonTerminatorInsn &insn) {
+    writer.write<uint8_t>(insn.getKind());
+    switch (insn.getKind()) {
+    case INSTRUCTION_KIND_NEW_ARRAY: {
+        const auto &arrayInsn = static_cast<const ArrayInsn &>(insn);
+        writer.writeOperand(arrayInsn.lhsOp);
+        writer.writeOperand(arrayInsn.sizeOp);
+        break;
+    }
+    case INSTRUCTION_KIND_ARRAY_STORE: {
+        const auto &storeInsn = static_cast<const ArrayStoreInsn &>(insn);
+        writer.writeOperand(storeInsn.lhsOp);
+        writer.writeOperand(storeInsn.keyOp);
+        writer.writeOperand(storeInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_ARRAY_LOAD: {
+        const auto &loadInsn = static_cast<const ArrayLoadInsn &>(insn);
+        writer.writeOperand(loadInsn.lhsOp);
+        writer.writeOperand(loadInsn.keyOp);
+        writer.writeOperand(loadInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_BINARY_ADD:
+    case INSTRUCTION_KIND_BINARY_SUB:
+    case INSTRUCTION_KIND_BINARY_MUL:
+    case INSTRUCTION_KIND_BINARY_DIV:
+    case INSTRUCTION_KIND_BINARY_MOD:
+    case INSTRUCTION_KIND_BINARY_EQUAL:
+    case INSTRUCTION_KIND_BINARY_NOT_EQUAL:
+    case INSTRUCTION_KIND_BINARY_GREATER_THAN:
+    case INSTRUCTION_KIND_BINARY_GREATER_EQUAL:
+    case INSTRUCTION_KIND_BINARY_LESS_THAN:
+    case INSTRUCTION_KIND_BINARY_LESS_EQUAL:
+    case INSTRUCTION_KIND_BINARY_BITWISE_XOR: {
+        const auto &binaryInsn = static_cast<const BinaryOpInsn &>(insn);
+        writer.writeOperand(binaryInsn.lhsOp);
+        writer.writeOperand(binaryInsn.rhsOp1);
+        writer.writeOperand(binaryInsn.rhsOp2);
+        break;
+    }
+    case INSTRUCTION_KIND_CONST_LOAD: {
+        const auto &constInsn = static_cast<const ConstantLoadInsn &>(insn);
+        writer.writeOperand(constInsn.lhsOp);
+        writer.write<uint8_t>(constInsn.typeTag);
+        switch (constInsn.typeTag) {
+        case TYPE_TAG_INT:
+            writer.write<int64_t>(std::get<int64_t>(constInsn.value));
+            break;
+        case TYPE_TAG_FLOAT: {
+            uint64_t bits = 0;
+            auto doubleValue = std::get<double>(constInsn.value);
+            static_assert(sizeof(bits) == sizeof(doubleValue));
+            std::memcpy(&bits, &doubleValue, sizeof(bits));
+            writer.write<uint64_t>(bits);
+            break;
+        }
+        case TYPE_TAG_BOOLEAN:
+            writer.write<uint8_t>(std::get<bool>(constInsn.value));
+            break;
+        case TYPE_TAG_STRING:
+            writer.writeString(std::get<std::string_view>(constInsn.value));
+            break;
+        case TYPE_TAG_NIL:
+            break;
+        default:
+            llvm_unreachable("Unsupported constant type");
+        }
+        break;
+    }
+    case INSTRUCTION_KIND_MAP_LOAD: {
+        const auto &loadInsn = static_cast<const MapLoadInsn &>(insn);
+        writer.writeOperand(loadInsn.lhsOp);
+        writer.writeOperand(loadInsn.keyOp);
+        writer.writeOperand(loadInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_MAP_STORE: {
+        const auto &storeInsn = static_cast<const MapStoreInsn &>(insn);
+        writer.writeOperand(storeInsn.lhsOp);
+        writer.writeOperand(storeInsn.keyOp);
+        writer.writeOperand(storeInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_MOVE: {
+        const auto &moveInsn = static_cast<const MoveInsn &>(insn);
+        writer.writeOperand(moveInsn.lhsOp);
+        writer.writeOperand(moveInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_NEW_STRUCTURE: {
+        const auto &structureInsn = static_cast<const StructureInsn &>(insn);
+        writer.writeOperand(structureInsn.lhsOp);
+        writer.write<uint32_t>(structureInsn.initValues.size());
+        for (const auto &initValue : structureInsn.initValues) {
+            writer.write<uint8_t>(initValue.getKind());
+            if (const auto *keyValue = std::get_if<MapConstruct::KeyValue>(&initValue.getInitValStruct())) {
+                writer.writeOperand(keyValue->getKey());
+                writer.writeOperand(keyValue->getValue());
+            } else {
+                writer.writeOperand(std::get<MapConstruct::SpreadField>(initValue.getInitValStruct()).getExpr());
+            }
+        }
+        break;
+    }
+    case INSTRUCTION_KIND_TYPE_CAST: {
+        const auto &castInsn = static_cast<const TypeCastInsn &>(insn);
+        writer.writeOperand(castInsn.lhsOp);
+        writer.writeOperand(castInsn.rhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_TYPE_TEST: {
+        writer.writeOperand(static_cast<const TypeTestInsn &>(insn).lhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_NEW_TYPEDESC: {
+        writer.writeOperand(static_cast<const TypeDescInsn &>(insn).lhsOp);
+        break;
+    }
+    case INSTRUCTION_KIND_UNARY_NEG:
+    case INSTRUCTION_KIND_UNARY_NOT: {
+        const auto &unaryInsn = static_cast<const UnaryOpInsn &>(insn);
+        writer.writeOperand(unaryInsn.lhsOp);
+        writer.writeOperand(unaryInsn.rhsOp);
+        break;
+    }
+    default:
+        llvm_unreachable("Unsupported non terminator instruction");
+    }
+}
+
+void PackageCache::writeTerminator(PackageCacheWriter &writer, const TerminatorInsn &insn) {
+    writer.write<uint8_t>(insn.getKind());
+    writer.writeString(insn.getThenBBID());
+    writer.write<uint32_t>(insn.getThenBBIndex());
+    switch (insn.getKind()) {
+    case INSTRUCTION_KIND_CONDITIONAL_BRANCH: {
+        const auto &branchInsn = static_cast<const ConditionBrInsn &>(insn);
+        writer.writeOperand(branchInsn.lhsOp);
+        writer.writeString(branchInsn.getElseBBID());
+        writer.write<uint32_t>(branchInsn.getElseBBIndex());
+        break;
+    }
+    case INSTRUCTION_KIND_CALL: {
+        const auto &callInsn = static_cast<const FunctionCallInsn &>(insn);
+        writer.writeOperand(callInsn.lhsOp);
+        writer.writeString(callInsn.functionName);
+        writer.write<int32_t>(callInsn.argCount);
+        writer.write<uint32_t>(callInsn.argsList.size());
+        for (const auto &arg : callInsn.argsList) {
+            writer.writeOperand(arg);
+        }
+        break;
+    }
+    case INSTRUCTION_KIND_GOTO:
+    case INSTRUCTION_KIND_RETURN:
+        break;
+    default:
+        llvm_unreachable("Unsupported terminator instruction");
+    }
+}
+
+bool PackageCache::readPackage(PackageCacheReader &reader, Package &package) {
+    package.org = std::string(reader.readString());
+    package.name = std::string(reader.readString());
+    package.version = std::string(reader.readString());
+    package.sourceFileName = std::string(reader.readString());
+
+    auto typeCount = reader.readCount();
+    for (uint32_t i = 0; i < typeCount; i++) {
+        auto tag = (TypeTag)reader.read<uint8_t>();
+        std::string name(reader.readString());
+        const Type *type = nullptr;
+        if (tag == TYPE_TAG_ARRAY) {
+            Type::ArrayType arrayType{(TypeTag)reader.read<uint8_t>(), reader.read<int32_t>(), reader.read<int32_t>()};
+            type = &package.types.intern(Type(tag, std::move(name), arrayType));
+        } else if (tag == TYPE_TAG_MAP) {
+            Type::MapType mapType{(TypeTag)reader.read<uint8_t>()};
+            type = &package.types.intern(Type(tag, std::move(name), mapType));
+        } else {
+            type = &package.types.intern(Type(tag, std::move(name)));
+        }
+        // A duplicate would shift the indices of all the types after it
+        if (type->getIndex() != i) {
+            return false;
+        }
+    }
+    reader.types = &package.types;
+
+    auto globalVarCount = reader.readCount();
+    package.globalVars.reserve(globalVarCount);
+    package.globalVarIndices.reserve(globalVarCount);
+    for (uint32_t i = 0; i < globalVarCount; i++) {
+        const auto *type = reader.readType();
+        auto name = reader.readString();
+        auto kind = (VarKind)reader.read<uint8_t>();
+        if (type == nullptr) {
+            return false;
+        }
+        package.globalVarIndices.emplace(name, package.globalVars.size());
+        package.globalVars.emplace_back(*type, name, kind);
+    }
+
+    // Reserved up front, the basic blocks point back at their function
+    auto functionCount = reader.readCount();
+    package.functions.reserve(functionCount);
+    for (uint32_t i = 0; i < functionCount; i++) {
+        if (!readFunction(reader, package)) {
+            return false;
+        }
+    }
+    package.functionIndices.reserve(package.functions.size());
+    for (size_t i = 0; i < package.functions.size(); i++) {
+        package.functionIndices.emplace(package.functions[i].getName(), i);
+    }
+    return !reader.hasFailed();
+}
+
+bool PackageCache::readFunction(PackageCacheReader &reader, Package &package) {
+    auto name = reader.readString();
+    auto workerName = reader.readString();
+    auto flags = reader.read<uint32_t>();
+    auto &function = package.functions.emplace_back(&package, name, workerName, flags);
+    auto fileName = reader.readString();
+    auto sLine = reader.read<int32_t>();
+    auto sCol = reader.read<int32_t>();
+    auto eLine = reader.read<int32_t>();
+    auto eCol = reader.read<int32_t>();
+    function.setLocation(Location(fileName, sLine, sCol, eLine, eCol));
+
+    if (reader.read<uint8_t>() != 0) {
+        auto paramCount = reader.readCount(sizeof(uint32_t));
+        std::vector<const Type *> paramTypes;
+        paramTypes.reserve(paramCount);
+        for (uint32_t i = 0; i < paramCount; i++) {
+            paramTypes.push_back(reader.readType());
+        }
+        const auto *returnType = reader.readType();
+        bool hasRestType = reader.read<uint8_t>() != 0;
+        const auto *restType = hasRestType ? reader.readType() : nullptr;
+        if (reader.hasFailed()) {
+            return false;
+        }
+        function.signature = hasRestType ? InvocableType(std::move(paramTypes), *restType, *returnType)
+                                         : InvocableType(std::move(paramTypes), *returnType);
+    }
+    if (reader.read<uint8_t>() != 0) {
+        const auto *type = reader.readType();
+        auto varName = reader.readString();
+        auto kind = (VarKind)reader.read<uint8_t>();
+        if (type == nullptr) {
+            return false;
+        }
+        function.returnVar = Variable(*type, varName, kind);
+    }
+    if (reader.read<uint8_t>() != 0) {
+        function.restParam = RestParam();
+    }
+
+    auto paramCount = reader.readCount();
+    function.requiredParams.reserve(paramCount);
+    for (uint32_t i = 0; i < paramCount; i++) {
+        auto param = reader.readOperand();
+        const auto *type = reader.readType();
+        if (type == nullptr) {
+            return false;
+        }
+        function.requiredParams.emplace_back(std::move(param), *type);
+    }
+    auto localVarCount = reader.readCount();
+    function.localVars.reserve(localVarCount);
+    function.localVarIndices.reserve(localVarCount);
+    for (uint32_t i = 0; i < localVarCount; i++) {
+        const auto *type = reader.readType();
+        auto varName = reader.readString();
+        auto kind = (VarKind)reader.read<uint8_t>();
+        if (type == nullptr) {
+            return false;
+        }
+        function.localVarIndices.emplace(varName, function.localVars.size());
+        function.localVars.emplace_back(*type, varName, kind);
+    }
+
+    auto basicBlockCount = reader.readCount();
+    function.basicBlocks.reserve(basicBlockCount);
+    for (uint32_t i = 0; i < basicBlockCount; i++) {
+        auto *basicBlock = function.arena.create<BasicBlock>(reader.readString(), &function);
+        function.basicBlocks.push_back(basicBlock);
+        auto insnCount = reader.readCount();
+        basicBlock->instructions.reserve(insnCount);
+        for (uint32_t j = 0; j < insnCount; j++) {
+            if (!readInstruction(reader, *basicBlock)) {
+                return false;
+            }
+        }
+        if (reader.read<uint8_t>() != 0 && !readTerminator(reader, *basicBlock)) {
+            return false;
+        }
+    }
+    return !reader.hasFailed();
+}
+
+bool PackageCache::readInstruction(PackageCacheReader &reader, BasicBlock &basicBlock) {
+    auto kind = (InstructionKind)reader.read<uint8_t>();
+    auto lhsOp = reader.readOperand();
+    NonTerminatorInsn *insn = nullptr;
+    switch (kind) {
+    case INSTRUCTION_KIND_NEW_ARRAY: {
+        auto sizeOp = reader.readOperand();
+        insn = basicBlock.createInsn<ArrayInsn>(std::move(lhsOp), basicBlock, std::move(sizeOp));
+        break;
+    }
+    case INSTRUCTION_KIND_ARRAY_STORE: {
+        auto keyOp = reader.readOperand();
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<ArrayStoreInsn>(std::move(lhsOp), basicBlock, std::move(keyOp), std::move(rhsOp));
+        break;
+    }
+    case INSTRUCTION_KIND_ARRAY_LOAD: {
+        auto keyOp = reader.readOperand();
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<ArrayLoadInsn>(std::move(lhsOp), basicBlock, std::move(keyOp), std::move(rhsOp));
+        break;
+    }
+    case INSTRUCTION_KIND_BINARY_ADD:
+    case INSTRUCTION_KIND_BINARY_SUB:
+    case INSTRUCTION_KIND_BINARY_MUL:
+    case INSTRUCTION_KIND_BINARY_DIV:
+    case INSTRUCTION_KIND_BINARY_MOD:
+    case INSTRUCTION_KIND_BINARY_EQUAL:
+    case INSTRUCTION_KIND_BINARY_NOT_EQUAL:
+    case INSTRUCTION_KIND_BINARY_GREATER_THAN:
+    case INSTRUCTION_KIND_BINARY_GREATER_EQUAL:
+    case INSTRUCTION_KIND_BINARY_LESS_THAN:
+    case INSTRUCTION_KIND_BINARY_LESS_EQUAL:
+    case INSTRUCTION_KIND_BINARY_BITWISE_XOR: {
+        auto rhsOp1 = reader.readOperand();
+        auto rhsOp2 = reader.readOperand();
+        insn = basicBlock.createInsn<BinaryOpInsn>(std::move(lhsOp), basicBlock, std::move(rhsOp1), std::move(rhsOp2),
+                                                   kind);
+        break;
+    }
+    case INSTRUCTION_KIND_CONST_LOAD: {
+        switch ((TypeTag)reader.read<uint8_t>()) {
+        case TYPE_TAG_INT:
+            insn = basicBlock.createInsn<ConstantLoadInsn>(std::move(lhsOp), basicBlock, reader.read<int64_t>());
+            break;
+        case TYPE_TAG_FLOAT: {
+            auto bits = reader.read<uint64_t>();
+            double doubleValue = 0;
+            std::memcpy(&doubleValue, &bits, sizeof(doubleValue));
+            insn = basicBlock.createInsn<ConstantLoadInsn>(std::move(lhsOp), basicBlock, doubleValue);
+            break;
+        }
+        case TYPE_TAG_BOOLEAN:
+            insn = basicBlock.createInsn<ConstantLoadInsn>(std::move(lhsOp), basicBlock, reader.read<uint8_t>() != 0);
+            break;
+        case TYPE_TAG_STRING:
+            insn = basicBlock.createInsn<ConstantLoadInsn>(std::move(lhsOp), basicBlock, reader.readString());
+            break;
+        case TYPE_TAG_NIL:
+            insn = basicBlock.createInsn<ConstantLoadInsn>(std::move(lhsOp), basicBlock);
+            break;
+        default:
+            return false;
+        }
+        break;
+    }
+    case INSTRUCTION_KIND_MAP_LOAD: {
+        auto keyOp = reader.readOperand();
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<MapLoadInsn>(std::move(lhsOp), basicBlock, std::move(keyOp), std::move(rhsOp));
+        break;
+    }
+    case INSTRUCTION_KIND_MAP_STORE: {
+        auto keyOp = reader.readOperand();
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<MapStoreInsn>(std::move(lhsOp), basicBlock, std::move(keyOp), std::move(rhsOp));
+        break;
+    }
+    case INSTRUCTION_KIND_MOVE: {
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<MoveInsn>(std::move(lhsOp), basicBlock, std::move(rhsOp));
+        break;
+    }
+    case INSTRUCTION_KIND_NEW_STRUCTURE: {
+        auto initValueCount = reader.readCount();
+        std::vector<MapConstruct> initValues;
+        initValues.reserve(initValueCount);
+        for (uint32_t i = 0; i < initValueCount; i++) {
+            auto initKind = (MapConstrctBodyKind)reader.read<uint8_t>();
+            if (initKind == Key_Value_Kind) {
+                auto keyOp = reader.readOperand();
+                auto valueOp = reader.readOperand();
+                initValues.emplace_back(MapConstruct::KeyValue(std::move(keyOp), std::move(valueOp)));
+            } else if (initKind == Spread_Field_Kind) {
+                initValues.emplace_back(MapConstruct::SpreadField(reader.readOperand()));
+            } else {
+                return false;
+            }
+        }
+        insn = basicBlock.createInsn<StructureInsn>(std::move(lhsOp), basicBlock, std::move(initValues));
+        break;
+    }
+    case INSTRUCTION_KIND_TYPE_CAST: {
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<TypeCastInsn>(std::move(lhsOp), basicBlock, std::move(rhsOp));
+        break;
+    }
+    case INSTRUCTION_KIND_TYPE_TEST:
+        insn = basicBlock.createInsn<TypeTestInsn>(std::move(lhsOp), basicBlock);
+        break;
+    case INSTRUCTION_KIND_NEW_TYPEDESC:
+        insn = basicBlock.createInsn<TypeDescInsn>(std::move(lhsOp), basicBlock);
+        break;
+    case INSTRUCTION_KIND_UNARY_NEG:
+    case INSTRUCTION_KIND_UNARY_NOT: {
+        auto rhsOp = reader.readOperand();
+        insn = basicBlock.createInsn<UnaryOpInsn>(std::move(lhsOp), basicBlock, std::move(rhsOp), kind);
+        break;
+    }
+    default:
+        return false;
+    }
+    basicBlock.addNonTermInsn(insn);
+    return !reader.hasFailed();
+}
+
+bool PackageCache::readTerminator(PackageCacheReader &reader, BasicBlock &basicBlock) {
+    auto kind = (InstructionKind)reader.read<uint8_t>();
+    auto thenBBID = reader.readString();
+    auto thenBBIndex = reader.read<uint32_t>();
+    TerminatorInsn *terminator = nullptr;
+    switch (kind) {
+    case INSTRUCTION_KIND_CONDITIONAL_BRANCH: {
+        auto lhsOp = reader.readOperand();
+        auto elseBBID = reader.readString();
+        auto elseBBIndex = reader.read<uint32_t>();
+        auto *branchInsn = basicBlock.createInsn<ConditionBrInsn>(std::move(lhsOp), basicBlock, thenBBID, elseBBID);
+        branchInsn->setElseBBIndex(elseBBIndex);
+        terminator = branchInsn;
+        break;
+    }
+    case INSTRUCTION_KIND_CALL: {
+        auto lhsOp = reader.readOperand();
+        auto functionName = reader.readString();
+        auto argCount = reader.read<int32_t>();
+        auto argsListSize = reader.readCount();
+        std::vector<Operand> argsList;
+        argsList.reserve(argsListSize);
+        for (uint32_t i = 0; i < argsListSize; i++) {
+            argsList.push_back(reader.readOperand());
+        }
+        terminator = basicBlock.createInsn<FunctionCallInsn>(basicBlock, thenBBID, std::move(lhsOp), functionName,
+                                                             argCount, std::move(argsList));
+        break;
+    }
+    case INSTRUCTION_KIND_GOTO:
+        terminator = basicBlock.createInsn<GoToInsn>(basicBlock, thenBBID);
+        break;
+    case INSTRUCTION_KIND_RETURN:
+        terminator = basicBlock.createInsn<ReturnInsn>(basicBlock);
+        break;
+    default:
+        return false;
+    }
+    terminator->setThenBBIndex(thenBBIndex);
+    basicBlock.setTerminatorInsn(terminator);
+    return !reader.hasFailed();
+}
+
+} // namespace nballerina
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "server/CompileServer.h"
+#include <iostream>
+
+#ifndef _WIN32
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#endif
+
+namespace nballerina {
+
+#ifdef _WIN32
+
+int CompileServer::serve(const std::string &, const CompileFunction &) {
+    std::cerr << "--server is not supported on Windows" << std::endl;
+    return 1;
+}
+
+int CompileServer::forward(const std::string &, llvm::ArrayRef<const char *>) { return -1; }
+
+#else
+
+// A request is a count followed by length prefixed strings: the working
+// directory of the client and then its command line. The reply is a sequence
+// of frames, a kind byte and a length prefixed payload, ending with the exit
+// status. Both ends are on the same machine, so integers are in host order.
+enum ServerFrameKind { SERVER_FRAME_EXIT = 0, SERVER_FRAME_STDOUT = 1, SERVER_FRAME_STDERR = 2 };
+
+static constexpr uint32_t MAX_REQUEST_STRINGS = 1 << 16;
+static constexpr uint32_t MAX_PAYLOAD_SIZE = 1 << 20;
+
+static bool writeAll(int fd, const void *data, size_t size) {
+    const auto *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool readAll(int fd, void *data, size_t size) {
+    auto *bytes = static_cast<char *>(data);
+    while (size > 0) {
+        ssize_t count = ::read(fd, bytes, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        bytes += count;
+        size -= count;
+    }
+    return true;
+}
+
+static bool writeFrame(int fd, uint8_t kind, const void *data, uint32_t size) {
+    return writeAll(fd, &kind, sizeof(kind)) && writeAll(fd, &size, sizeof(size)) && writeAll(fd, data, size);
+}
+
+static bool writeRequest(int fd, const std::vector<std::string> &request) {
+    auto count = static_cast<uint32_t>(request.size());
+    if (!writeAll(fd, &count, sizeof(count))) {
+        return false;
+    }
+    for (const auto &value : request) {
+        auto size = static_cast<uint32_t>(value.size());
+        if (!writeAll(fd, &size, sizeof(size)) || !writeAll(fd, value.data(), size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool readRequest(int fd, std::vector<std::string> &request) {
+    uint32_t count = 0;
+    if (!readAll(fd, &count, sizeof(count)) || count > MAX_REQUEST_STRINGS) {
+        return false;
+    }
+    request.resize(count);
+    for (auto &value : request) {
+        uint32_t size = 0;
+        if (!readAll(fd, &size, sizeof(size)) || size > MAX_PAYLOAD_SIZE) {
+            return false;
+        }
+        value.resize(size);
+        if (!readAll(fd, value.data(), size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool makeAddress(const std::string &socketPath, sockaddr_un &address) {
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << socketPath << std::endl;
+        return false;
+    }
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    return true;
+}
+
+// Runs the compile in a worker process of its own, as errors in a dump abort
+// the process and the statistics and time trace state is process wide. The
+// worker output is relayed to the client as it comes, and its exit status
+// (128 plus the signal number if it crashed) is sent last.
+static int handleConnection(int connection, const CompileServer::CompileFunction &compile) {
+    std::vector<std::string> request;
+    if (!readRequest(connection, request) || request.size() < 2) {
+        return 1;
+    }
+    int outPipe[2];
+    int errPipe[2];
+    if (pipe(outPipe) != 0 || pipe(errPipe) != 0) {
+        return 1;
+    }
+    // The server ignores SIGCHLD to reap handlers, which would make waitpid fail here
+    signal(SIGCHLD, SIG_DFL);
+    pid_t worker = fork();
+    if (worker < 0) {
+        return 1;
+    }
+    if (worker == 0) {
+        close(connection);
+        dup2(outPipe[1], STDOUT_FILENO);
+        dup2(errPipe[1], STDERR_FILENO);
+        for (int fd : {outPipe[0], outPipe[1], errPipe[0], errPipe[1]}) {
+            close(fd);
+        }
+        int devNull = open("/dev/null", O_RDONLY);
+        dup2(devNull, STDIN_FILENO);
+        close(devNull);
+        if (chdir(request[0].c_str()) != 0) {
+            std::cerr << "Unable to change to directory " << request[0] << ": " << std::strerror(errno) << std::endl;
+            exit(1);
+        }
+        std::vector<const char *> args;
+        args.reserve(request.size() - 1);
+        for (size_t i = 1; i < request.size(); i++) {
+            args.push_back(request[i].c_str());
+        }
+        // exit rather than _exit, so that buffered output is flushed
+        exit(compile(args));
+    }
+    close(outPipe[1]);
+    close(errPipe[1]);
+
+    pollfd pipes[] = {{outPipe[0], POLLIN, 0}, {errPipe[0], POLLIN, 0}};
+    const uint8_t kinds[] = {SERVER_FRAME_STDOUT, SERVER_FRAME_STDERR};
+    int openPipes = 2;
+    std::vector<char> buffer(64 * 1024);
+    while (openPipes > 0) {
+        if (poll(pipes, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (size_t i = 0; i < 2; i++) {
+            if (pipes[i].fd < 0 || pipes[i].revents == 0) {
+                continue;
+            }
+            ssize_t count = read(pipes[i].fd, buffer.data(), buffer.size());
+            if (count > 0) {
+                // A client that went away is not an error, the worker runs to completion
+                writeFrame(connection, kinds[i], buffer.data(), static_cast<uint32_t>(count));
+            } else if (count == 0 || errno != EINTR) {
+                close(pipes[i].fd);
+                pipes[i].fd = -1;
+                openPipes--;
+            }
+        }
+    }
+
+    int status = 0;
+    while (waitpid(worker, &status, 0) < 0 && errno == EINTR) {
+    }
+    int32_t result = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    writeFrame(connection, SERVER_FRAME_EXIT, &result, sizeof(result));
+    return 0;
+}
+
+int CompileServer::serve(const std::string &socketPath, const CompileFunction &compile) {
+    sockaddr_un address;
+    if (!makeAddress(socketPath, address)) {
+        return 1;
+    }
+    // A socket left behind by a server that was killed
+    struct stat info;
+    if (lstat(socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(socketPath.c_str());
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::cerr << "Unable to create socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    // Only the owner may connect, a request can write any file the server can
+    mode_t previousMask = umask(S_IRWXG | S_IRWXO);
+    int bound = bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+    umask(previousMask);
+    if (bound != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "Unable to listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        close(listener);
+        return 1;
+    }
+
+    // Handlers are reaped by the system, and a client going away mid reply
+    // must not take the server down
+    signal(SIGCHLD, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+    std::cout << "Compile server listening on " << socketPath << std::endl;
+
+    // Requests are served concurrently, each by a handler process forked from
+    // this already initialized one
+    while (true) {
+        int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            std::cerr << "Unable to accept connection: " << std::strerror(errno) << std::endl;
+            close(listener);
+            return 1;
+        }
+        pid_t handler = fork();
+        if (handler == 0) {
+            close(listener);
+            int result = handleConnection(connection, compile);
+            close(connection);
+            _exit(result);
+        }
+        if (handler < 0) {
+            std::cerr << "Unable to fork: " << std::strerror(errno) << std::endl;
+        }
+        close(connection);
+    }
+}
+
+int CompileServer::forward(const std::string &socketPath, llvm::ArrayRef<const char *> args) {
+    sockaddr_un address;
+    llvm::SmallString<256> workingDirectory;
+    if (!makeAddress(socketPath, address) || llvm::sys::fs::current_path(workingDirectory)) {
+        return -1;
+    }
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0) {
+        return -1;
+    }
+    if (connect(connection, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        close(connection);
+        return -1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    std::vector<std::string> request{std::string(workingDirectory)};
+    request.insert(request.end(), args.begin(), args.end());
+    if (!writeRequest(connection, request)) {
+        close(connection);
+        return -1;
+    }
+
+    std::vector<char> payload;
+    while (true) {
+        uint8_t kind = 0;
+        uint32_t size = 0;
+        if (!readAll(connection, &kind, sizeof(kind)) || !readAll(connection, &size, sizeof(size)) ||
+            size > MAX_PAYLOAD_SIZE) {
+            break;
+        }
+        payload.resize(size);
+        if (!readAll(connection, payload.data(), size)) {
+            break;
+        }
+        if (kind == SERVER_FRAME_EXIT && size == sizeof(int32_t)) {
+            int32_t result = 0;
+            std::memcpy(&result, payload.data(), sizeof(result));
+            close(connection);
+            return result;
+        }
+        writeAll(kind == SERVER_FRAME_STDOUT ? STDOUT_FILENO : STDERR_FILENO, payload.data(), size);
+    }
+    close(connection);
+    std::cerr << "Lost connection to the compile server on " << socketPath << std::endl;
+    return 1;
+}
+
+#endif
+
+} // namespace nballerina
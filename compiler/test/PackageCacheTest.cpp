@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021, WSO2 Inc. (http://www.wso2.org) All Rights Reserved.
+ *
+ * WSO2 Inc. licenses this file to you under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "bir/Function.h"
+#include "bir/Package.h"
+#include "bir/TypeTable.h"
+#include "reader/BIRFileReader.h"
+#include "reader/PackageCache.h"
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace nballerina;
+
+namespace {
+
+// Generated with test/gen_large_function.py when the test is built
+const std::string dumpPath = PACKAGE_CACHE_TEST_DUMP;
+
+std::string readFile(const std::string &path) {
+    auto fileOrErr = llvm::MemoryBuffer::getFile(path, -1, false);
+    return fileOrErr ? (*fileOrErr)->getBuffer().str() : std::string();
+}
+
+void writeFile(const std::string &path, const std::string &contents) {
+    std::error_code EC;
+    llvm::raw_fd_ostream out(path, EC, llvm::sys::fs::OF_None);
+    out << contents;
+}
+
+class PackageCacheTest : public ::testing::Test {
+  protected:
+    llvm::SmallString<128> cacheDirectory;
+    ReaderOptions options;
+    uint64_t key = 0;
+    std::string entryPath;
+
+    void SetUp() override {
+        ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("nballerina-bir-cache", cacheDirectory));
+        options.cacheDirectory = std::string(cacheDirectory);
+        key = PackageCache::getKey(readFile(dumpPath), options);
+        entryPath = PackageCache::getPath(options.cacheDirectory, key);
+        // The first read misses and writes the entry
+        BIRFileReader::deserialize(dumpPath, options);
+        ASSERT_TRUE(llvm::sys::fs::exists(entryPath));
+    }
+
+    void TearDown() override { llvm::sys::fs::remove_directories(cacheDirectory); }
+};
+
+} // namespace
+
+TEST_F(PackageCacheTest, LoadMatchesDecode) {
+    auto decoded = BIRFileReader::deserialize(dumpPath);
+    auto loaded = PackageCache::load(entryPath, key);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getModuleName(), decoded->getModuleName());
+    EXPECT_EQ(loaded->getTypeTable().size(), decoded->getTypeTable().size());
+    EXPECT_EQ(loaded->getArenaBytes(), decoded->getArenaBytes());
+    EXPECT_EQ(loaded->getFunction("large").getInstructionCount(),
+              decoded->getFunction("large").getInstructionCount());
+}
+
+TEST_F(PackageCacheTest, StoreAfterLoadIsByteIdentical) {
+    auto loaded = PackageCache::load(entryPath, key);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_TRUE(PackageCache::store(*loaded, entryPath + ".again", key));
+    EXPECT_EQ(readFile(entryPath), readFile(entryPath + ".again"));
+}
+
+TEST_F(PackageCacheTest, RejectsOtherKey) { EXPECT_EQ(PackageCache::load(entryPath, key + 1), nullptr); }
+
+TEST_F(PackageCacheTest, RejectsTruncatedEntry) {
+    auto entry = readFile(entryPath);
+    writeFile(entryPath, entry.substr(0, entry.size() / 2));
+    EXPECT_EQ(PackageCache::load(entryPath, key), nullptr);
+
+    // The next read decodes the dump again and rewrites the entry
+    BIRFileReader::deserialize(dumpPath, options);
+    EXPECT_EQ(readFile(entryPath), entry);
+}
+
+TEST_F(PackageCacheTest, RejectsFlippedBit) {
+    auto entry = readFile(entryPath);
+    auto damaged = entry;
+    damaged[damaged.size() / 2] ^= 0x10;
+    writeFile(entryPath, damaged);
+    EXPECT_EQ(PackageCache::load(entryPath, key), nullptr);
+
+    BIRFileReader::deserialize(dumpPath, options);
+    EXPECT_EQ(readFile(entryPath), entry);
+}
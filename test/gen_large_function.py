@@ -0,0 +1,131 @@
+import struct
+import sys
+
+# Writes a BIR dump with one large int function for nballerinacc --bench-codegen,
+# e.g. python3 gen_large_function.py large-bir-dump 20000
+#
+# Every basic block loads a constant, adds and multiplies it into an
+# accumulator and jumps to the next block. The last block moves the
+# accumulator to the return variable.
+
+if len(sys.argv) < 2:
+    print('usage: gen_large_function.py <output> [basic blocks]')
+    sys.exit(-1)
+
+out_file = sys.argv[1]
+block_count = int(sys.argv[2]) if len(sys.argv) > 2 else 10000
+
+CP_INTEGER = 1
+CP_STRING = 4
+CP_PACKAGE = 5
+CP_SHAPE = 7
+
+TYPE_TAG_INT = 1
+TYPE_TAG_INVOKABLE = 16
+
+RETURN_VAR_KIND = 4
+TEMP_VAR_KIND = 3
+
+INSN_GOTO = 1
+INSN_RETURN = 4
+INSN_MOVE = 20
+INSN_CONST_LOAD = 21
+INSN_BINARY_ADD = 61
+INSN_BINARY_MUL = 63
+
+
+def s4(value):
+    return struct.pack('>i', value)
+
+
+def s8(value):
+    return struct.pack('>q', value)
+
+
+def u1(value):
+    return bytes([value])
+
+
+constant_pool = []
+constant_indices = {}
+
+
+def add_constant(key, data):
+    if key not in constant_indices:
+        constant_indices[key] = len(constant_pool)
+        constant_pool.append(data)
+    return constant_indices[key]
+
+
+def string_cp(value):
+    encoded = value.encode()
+    return add_constant(('s', value), u1(CP_STRING) + s4(len(encoded)) + encoded)
+
+
+def int_cp(value):
+    return add_constant(('i', value), u1(CP_INTEGER) + s8(value))
+
+
+empty = string_cp('')
+package = add_constant('package', u1(CP_PACKAGE) + s4(string_cp('gen')) + s4(string_cp('large')) +
+                       s4(string_cp('0.1.0')))
+int_type = add_constant('int', u1(CP_SHAPE) + s4(17) + u1(TYPE_TAG_INT) + s4(empty) + s8(0) + s4(0))
+fn_type = add_constant('fn', u1(CP_SHAPE) + s4(27) + u1(TYPE_TAG_INVOKABLE) + s4(empty) + s8(0) + s4(0) + u1(0) +
+                       s4(0) + u1(0) + s4(int_type))
+source = string_cp('large.bal')
+position = s4(source) + s4(1) * 4
+
+
+def operand(name, kind):
+    return u1(0) + u1(kind) + u1(0) + s4(string_cp(name))
+
+
+def local_var(name, kind):
+    return u1(kind) + s4(int_type) + s4(string_cp(name))
+
+
+def basic_block(name, insns):
+    return s4(string_cp(name)) + s4(len(insns)) + b''.join(position + insn for insn in insns)
+
+
+def function(name, blocks, temps):
+    body = s4(0) + u1(1) + local_var('%0', RETURN_VAR_KIND) + s4(0)
+    body += s4(len(temps) + 1) + local_var('%0', RETURN_VAR_KIND)
+    body += b''.join(local_var(temp, TEMP_VAR_KIND) for temp in temps)
+    body += s4(len(blocks)) + b''.join(blocks) + s4(0) + s4(0)
+    name_cp = string_cp(name)
+    header = position + s4(name_cp) + s4(name_cp) + s8(1) + u1(0) + s4(fn_type) + s8(0) + s4(0) + u1(0) + u1(0)
+    header += s8(0) + s4(0) + s4(0) + s8(0) + s4(0) + s8(len(body))
+    return header + body
+
+
+def large_function():
+    temps = ['%acc'] + ['%t{}'.format(i) for i in range(block_count)]
+    acc = operand('%acc', TEMP_VAR_KIND)
+    blocks = []
+    for i in range(block_count):
+        temp = operand('%t{}'.format(i), TEMP_VAR_KIND)
+        insns = []
+        if i == 0:
+            insns.append(u1(INSN_CONST_LOAD) + s4(int_type) + acc + s4(int_cp(1)))
+        insns.append(u1(INSN_CONST_LOAD) + s4(int_type) + temp + s4(int_cp(i % 97 + 1)))
+        insns.append(u1(INSN_BINARY_ADD) + acc + temp + acc)
+        insns.append(u1(INSN_BINARY_MUL) + acc + temp + temp)
+        if i + 1 < block_count:
+            insns.append(u1(INSN_GOTO) + s4(string_cp('bb{}'.format(i + 1))))
+        else:
+            insns.append(u1(INSN_MOVE) + acc + operand('%0', RETURN_VAR_KIND))
+            insns.append(u1(INSN_RETURN))
+        blocks.append(basic_block('bb{}'.format(i), insns))
+    return function('large', blocks, temps)
+
+
+def init_function():
+    insns = [u1(INSN_CONST_LOAD) + s4(int_type) + operand('%0', RETURN_VAR_KIND) + s4(int_cp(0)), u1(INSN_RETURN)]
+    return function('.<init>', [basic_block('bb0', insns)], [])
+
+
+functions = [large_function(), init_function()]
+module = s4(package) + s4(0) * 5 + s4(len(functions)) + b''.join(functions)
+with open(out_file, 'wb') as out:
+    out.write(s4(len(constant_pool)) + b''.join(constant_pool) + module)
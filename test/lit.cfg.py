@@ -1,4 +1,5 @@
 import lit.formats
+import lit.util
 from platform import system
 
 config.name = 'Ballerina codegen'
@@ -16,6 +17,8 @@ if system() == 'Windows':
 else:
    nballerinacc_path = os.path.join(config.my_obj_root, 'nballerinacc')
    run_script = 'testRunScript.sh' 
+   # Only testRunScript.sh takes extra nballerinacc options and input modes
+   config.available_features.add('run-script-options')
  
 config.substitutions.append(('%nballerinacc', nballerinacc_path))
 
@@ -25,5 +28,9 @@ config.substitutions.append(('%skip_bir_gen',config.skip_bir_gen))
 
 config.substitutions.append(('%target_variant',config.target_variant.lower())) 
 
+# Compressed dumps need nballerinacc built with zstd and the zstd tool
+if config.zstd_enabled and lit.util.which('zstd'):
+   config.available_features.add('zstd')
+
 config.substitutions.append(('%testRunScript',
     os.path.join(config.test_source_root, run_script)))
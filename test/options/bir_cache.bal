@@ -0,0 +1,28 @@
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "%skip_bir_gen" | filecheck %s
+// RUN: rm -rf %t.bir-cache
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--bir-cache=%t.bir-cache" | filecheck --check-prefix=COLD %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--bir-cache=%t.bir-cache" | filecheck --check-prefix=WARM %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--bir-cache=%t.bir-cache --emit=obj" obj | filecheck --check-prefix=WARM %s
+// REQUIRES: run-script-options
+
+public function print_string(string val) = external;
+
+public function print_integer(int val) = external;
+
+public function scale(int x, int factor) returns int {
+    return x * factor;
+}
+
+public function main() {
+    int a = 3;
+    int b = 5;
+    print_string("RESULT=");
+    print_integer(scale(a, b));
+}
+// CHECK: RESULT=15
+
+// COLD: BIR cache: miss
+// COLD: RESULT=15
+
+// WARM: BIR cache: hit
+// WARM: RESULT=15
@@ -0,0 +1,25 @@
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "%skip_bir_gen" "-O2" | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--emit=obj" obj | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "-O2 --emit=obj" obj | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--emit=asm" asm | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--emit=bc" bc | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "-O2 --emit=bc" bc | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "" run | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "-O2" run | filecheck %s
+// REQUIRES: run-script-options
+
+public function print_string(string val) = external;
+
+public function print_integer(int val) = external;
+
+public function bar(int x, int y, int z) returns int {
+    return x + y * z;
+}
+
+public function main() {
+    int a = 5;
+    int b = 2;
+    print_string("RESULT=");
+    print_integer(bar(a, b, a));
+}
+// CHECK: RESULT=15
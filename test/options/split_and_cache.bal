@@ -0,0 +1,37 @@
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "%skip_bir_gen" "--reachable-only" | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--split-codegen=2" split | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--split-codegen=2 --emit=obj" split | filecheck %s
+// RUN: rm -rf %t.cache
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--emit=obj --cache-dir=%t.cache" rsp | filecheck --check-prefix=COLD %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--emit=obj --cache-dir=%t.cache" rsp | filecheck --check-prefix=WARM %s
+// REQUIRES: run-script-options
+
+public function print_string(string val) = external;
+
+public function print_integer(int val) = external;
+
+public function square(int x) returns int {
+    return x * x;
+}
+
+public function bar(int x, int y) returns int {
+    return square(x) - y;
+}
+
+function unused(int x) returns int {
+    return x + 1;
+}
+
+public function main() {
+    int a = 5;
+    int b = 10;
+    print_string("RESULT=");
+    print_integer(bar(a, b));
+}
+// CHECK: RESULT=15
+
+// COLD: Function cache: 0 hits, {{[1-9][0-9]*}} misses
+// COLD: RESULT=15
+
+// WARM: Function cache: {{[1-9][0-9]*}} hits, 0 misses
+// WARM: RESULT=15
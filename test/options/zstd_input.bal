@@ -0,0 +1,19 @@
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "%skip_bir_gen" "" zstd | filecheck %s
+// RUN: "%testRunScript" %s %nballerinacc "%java_path" "%target_variant" "1" "--reader=stream" zstd | filecheck %s
+// REQUIRES: run-script-options, zstd
+
+public function print_string(string val) = external;
+
+public function print_integer(int val) = external;
+
+public function bar(int x, int y) returns int {
+    return x * y + 5;
+}
+
+public function main() {
+    int a = 5;
+    int b = 2;
+    print_string("RESULT=");
+    print_integer(bar(a, b));
+}
+// CHECK: RESULT=15
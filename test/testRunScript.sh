@@ -10,6 +10,21 @@ then
   exit 1
 fi
 
+# Extra nballerinacc options are passed in the sixth input arg, and the seventh
+# selects how the BIR dump is given to nballerinacc and what is linked:
+#   ll (default) : the .ll file is compiled with clang and linked
+#   stdin        : the dump is piped in through stdin, the .ll read from stdout
+#   zstd         : the dump is compressed with zstd first
+#   obj / asm    : the .o (--emit=obj) is linked directly, the .s (--emit=asm) is assembled first
+#   bc           : the .bc (--emit=bc) is linked with ThinLTO, as in the README
+#   split        : every .N.ll or .N.o partition (--split-codegen) is linked, the .ll compiled first
+#   rsp          : the fragments listed in the .rsp (--cache-dir) are linked
+#   run          : main is JIT compiled and run by nballerinacc (--run)
+options=$6
+mode=${7:-ll}
+runtime_dirs="-L../../runtime/rust_rt/$4/ -L../../runtime/c_rt/"
+runtime_libs="-lballerina_rt -lballerina_crt -lpthread -ldl"
+
 # Skip BIR dump generation if forth input arg is set
 if [ -z "$5" ]
 then
@@ -28,7 +43,29 @@ fi
 #  exit 1
 #fi
 
-$2 $filename-bir-dump  2>nbal_err.log
+case $mode in
+  stdin)
+    $2 $options - <$filename-bir-dump >$filename-bir-dump.ll 2>nbal_err.log
+    ;;
+  zstd)
+    zstd -q -f $filename-bir-dump -o $filename-bir-dump.zst
+    $2 $options $filename-bir-dump.zst -o $filename-bir-dump.ll 2>nbal_err.log
+    rm $filename-bir-dump.zst
+    ;;
+  run)
+    $2 $options --run --runtime-lib=../../runtime/rust_rt/$4/libballerina_rt.a \
+      --runtime-lib=../../runtime/c_rt/libballerina_crt.a $filename-bir-dump 2>nbal_err.log
+    ;;
+  *)
+    $2 $options $filename-bir-dump 2>nbal_err.log
+    ;;
+esac
+nbal_status=$?
+
+# --cache-dir and --bir-cache report their hits and misses on stderr
+grep -E "^(Function|BIR) cache: " nbal_err.log
+grep -v -E "^(Function|BIR) cache: " nbal_err.log >nbal_err.tmp
+mv nbal_err.tmp nbal_err.log
 
 if [ -s ./nbal_err.log ]
 then
@@ -37,7 +74,52 @@ then
   exit 1
 fi
 
-clang-11 --target=x86_64-unknown-linux-gnu -c -O3 -flto=thin -Wno-override-module -o $filename.o $filename-bir-dump.ll 2>clang_err.log
+if [ $nbal_status -ne 0 ]
+then
+  echo "nballerinacc failed with exit status $nbal_status"
+  exit 1
+fi
+
+if [ "$mode" == "run" ]
+then
+  exit 0
+fi
+
+rm -f clang_err.log
+case $mode in
+  obj)
+    objects=$filename-bir-dump.o
+    ;;
+  asm)
+    clang-11 --target=x86_64-unknown-linux-gnu -c -o $filename.o $filename-bir-dump.s 2>clang_err.log
+    objects=$filename.o
+    rm $filename-bir-dump.s
+    ;;
+  bc)
+    objects=$filename-bir-dump.bc
+    ;;
+  rsp)
+    objects=@$filename-bir-dump.rsp
+    ;;
+  split)
+    objects=""
+    for partition in $filename-bir-dump.[0-9]*.*
+    do
+      if [ "${partition##*.}" == "ll" ]
+      then
+        clang-11 --target=x86_64-unknown-linux-gnu -c -O3 -flto=thin -Wno-override-module -o ${partition%.ll}.o \
+          $partition 2>>clang_err.log
+        rm $partition
+      fi
+      objects="$objects ${partition%.*}.o"
+    done
+    ;;
+  *)
+    clang-11 --target=x86_64-unknown-linux-gnu -c -O3 -flto=thin -Wno-override-module -o $filename.o $filename-bir-dump.ll 2>clang_err.log
+    objects=$filename.o
+    rm $filename-bir-dump.ll
+    ;;
+esac
 
 if [ -s ./clang_err.log ]
 then
@@ -46,7 +128,19 @@ then
   exit 1
 fi
 
-clang-11 -flto=thin -fuse-ld=lld-11 -L../../runtime/rust_rt/$4/ -L../../runtime/c_rt/ -lballerina_rt -lballerina_crt -lpthread -ldl -o $filename.out -O3 $filename.o 2>lld_err.log
+case $mode in
+  bc)
+    clang-11 -flto=thin -fuse-ld=lld-11 -Wl,--thinlto-cache-dir=$filename.thinlto-cache $runtime_dirs $runtime_libs \
+      -o $filename.out -O3 $objects 2>lld_err.log
+    rm -rf $filename.thinlto-cache
+    ;;
+  rsp)
+    clang-11 -fuse-ld=lld-11 $runtime_dirs $runtime_libs -o $filename.out $objects 2>lld_err.log
+    ;;
+  *)
+    clang-11 -flto=thin -fuse-ld=lld-11 $runtime_dirs $runtime_libs -o $filename.out -O3 $objects 2>lld_err.log
+    ;;
+esac
 if [ -s ./lld_err.log ]
 then
   echo "Linker error/warning. Error msg: "
@@ -56,4 +150,10 @@ fi
 
 ./$filename.out
 
-rm $filename-bir-dump.ll $filename.out $filename.o
+rm $filename.out
+if [ "$mode" != "rsp" ]
+then
+  rm $objects
+else
+  rm $filename-bir-dump.rsp
+fi